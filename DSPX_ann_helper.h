@@ -33,9 +33,10 @@ namespace artificial_neural_networks
 		std::generate(_Cont.begin(), _Cont.end(), _RealDraw(_m, _M));
 	}
 
-	inline void _UninitializedRand(real_type& _Val, const real_type& _m, const real_type& _M)
-	{
-		_Val= _RealDraw(_m, _M)();
+	template <class T> inline
+		void _UninitializedRand(T& _Val, const real_type& _m, const real_type& _M)
+	{// drawn in double, rounded to T
+		_Val= static_cast<T>(_RealDraw(_m, _M)());
 	}
 
 	inline real_type _UninitializedRand(const real_type& _m, const real_type& _M)
@@ -93,30 +94,42 @@ namespace artificial_neural_networks
 
 	// functors
 
-	struct logistic
+	// the activation functor carries the scalar type T of the network
+
+	template <class T>
+	struct logistic_t
 	{// sigmoid 0;1
-		static const real_type _Lambda1;
+		typedef T			value_type;
+
+		static const T _Lambda1;
 
-		static real_type execute(const real_type& x) { return 1/ (1+ std::pow(M_E, -x/_Lambda1)); }
+		static T execute(const T& x) { return 1/ (1+ std::pow(static_cast<T>(M_E), -x/_Lambda1)); }
 
-		static real_type derivative(const real_type& x) { return x * (1-x); }
+		static T derivative(const T& x) { return x * (1-x); }
 
-		static real_type invert(const real_type& x) { return -_Lambda1 * std::log(1.0/x - 1.0); }
+		static T invert(const T& x) { return -_Lambda1 * std::log(T(1)/x - T(1)); }
 	};
 
-	const real_type logistic::_Lambda1 = 2.0;
+	template <class T> const T logistic_t<T>::_Lambda1 = T(2.0);
 
 
-	struct hyperbolic_tangent
+	template <class T>
+	struct hyperbolic_tangent_t
 	{// sigmoid -1;1
-		static const real_type _Lambda2;
+		typedef T			value_type;
 
-		static real_type execute(const real_type& x) { return std::tanh(x/_Lambda2); } //{ return std::tanh(0.5*x); }
+		static const T _Lambda2;
 
-		static real_type derivative(const real_type& x) { return 1- std::pow(x,2); }
+		static T execute(const T& x) { return std::tanh(x/_Lambda2); } //{ return std::tanh(0.5*x); }
 
-		static real_type invert(const real_type& x) { return _Lambda2 * std::log((1.0+x)/(1.0-x))/2; }
+		static T derivative(const T& x) { return 1- std::pow(x,2); }
+
+		static T invert(const T& x) { return _Lambda2 * std::log((T(1)+x)/(T(1)-x))/2; }
 	};
 
-	const real_type hyperbolic_tangent::_Lambda2 = 80.0;
+	template <class T> const T hyperbolic_tangent_t<T>::_Lambda2 = T(80.0);
+
+
+	typedef logistic_t<real_type>				logistic;
+	typedef hyperbolic_tangent_t<real_type>		hyperbolic_tangent;
 }
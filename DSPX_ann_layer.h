@@ -104,7 +104,7 @@ namespace artificial_neural_networks
 				I->dump_weights(s);
 		}
 
-		void save(std::ofstream& fout) const
+		void save(std::ostream& fout) const
 		{
 			for (auto I=cbegin(), E=cend(); I!=E; ++I)
 
@@ -122,7 +122,7 @@ namespace artificial_neural_networks
 			fout << "\n";
 		}
 
-		bool load(std::ifstream& fin, const size_t& _Nsz, const size_t& _Inputsz)
+		bool load(std::istream& fin, const size_t& _Nsz, const size_t& _Inputsz)
 		{
 			clear(); _neurons.resize(_Nsz);
 
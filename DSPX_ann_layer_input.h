@@ -7,20 +7,21 @@
 namespace artificial_neural_networks
 {
 
-	class input_layer : public layer<std::vector<real_type>>
+	template <class T>
+	class input_layer_t : public layer<std::vector<T>>
 	{
 		// provides conventional raw input copy into the network
 
-		typedef layer<std::vector<real_type>>		base;
+		typedef layer<std::vector<T>>				base;
 
 	public:
 
 
-		input_layer(const size_t& _Sz)
+		input_layer_t(const size_t& _Sz)
 			: base(_Sz)
 		{}
 
-		~input_layer() {}
+		~input_layer_t() {}
 
 
 		template <class _inIt>
@@ -41,4 +42,6 @@ namespace artificial_neural_networks
 
 	private:
 	};
+
+	typedef input_layer_t<real_type>	input_layer;
 }
\ No newline at end of file
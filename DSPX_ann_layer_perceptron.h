@@ -32,8 +32,9 @@ namespace artificial_neural_networks
 		template <class _LayerType>
 		void feed(const _LayerType& _L)
 		{
-			// feed forward each neuron of the _L layer	
-			_foreach(std::bind2nd(std::mem_fun_ref(&perceptron_type::feed<_LayerType>), _L));
+			// feed forward each neuron of the _L layer, 
+			// overload resolution picks the raw-input feed of input_layer_t
+			for (auto I= begin(), E= end(); I!=E; ++I) I->feed(_L);
 		}
 
 		template <class _LayerType>
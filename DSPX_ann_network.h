@@ -55,13 +55,27 @@ namespace artificial_neural_networks
 
 			if (!fin.good()) return false;
 
+			return _read(fin);
+		}
+
+		void _save(const path_type& P) const
+		{
+			std::ofstream fout(P.string(), std::ios::binary);
+
+			_write(fout);
+		}
+
+		bool _read(std::istream& fin)
+		{// binary layers, as _write() stores them
 			std::vector<size_t> layersizes(tuple_size_type::value); // contains input layer size
 			
 			for (size_t i=0; i<layersizes.size(); ++i)
 			{
-				char* ptr = reinterpret_cast<char*>(&layersizes[i]);
+				std::uint64_t sz(0); // portable across 32/64 bit builds, see _savesize()
+
+				fin.read(reinterpret_cast<char*>(&sz), sizeof(sz));
 
-				fin.read(ptr, sizeof(size_t));
+				layersizes[i] = size_t(sz);
 			}
 
 
@@ -72,35 +86,33 @@ namespace artificial_neural_networks
 			return fin.good();
 		}
 
-		void _save(const path_type& P) const
+		void _write(std::ostream& fout) const
 		{
-			std::ofstream fout(P.string(), std::ios::binary);
-
 			_savesize<0>(fout); // save input size too
 
 			_save<1>(fout);
 		}
 
 		template <size_t I>
-		void _save(std::ofstream& fout) const { _layer<I>().save(fout); return _save<I+1>(fout); }
+		void _save(std::ostream& fout) const { _layer<I>().save(fout); return _save<I+1>(fout); }
 
 		template <>
-		void _save <tuple_size_type::value> (std::ofstream& fout) const { }
+		void _save <tuple_size_type::value> (std::ostream& fout) const { }
 
 		template <size_t I>
-		void _savesize(std::ofstream& fout) const 
+		void _savesize(std::ostream& fout) const 
 		{ 
-			size_t sz = _layer<I>().size(); 
+			const std::uint64_t sz = _layer<I>().size(); // as size_t on 64 bit builds
 
 			const char* ptr = reinterpret_cast<const char*> (&sz);
 
-			fout.write(ptr, sizeof(size_t));
+			fout.write(ptr, sizeof(sz));
 
 			return _savesize<I+1>(fout);
 		}
 
 		template <>
-		void _savesize <tuple_size_type::value>(std::ofstream& fout) const {}
+		void _savesize <tuple_size_type::value>(std::ostream& fout) const {}
 
 		void _dump(const path_type& P) const
 		{
@@ -123,7 +135,7 @@ namespace artificial_neural_networks
 
 
 		template <size_t I>
-		void _load(std::ifstream& fin, const std::vector<size_t>& _layersizes)
+		void _load(std::istream& fin, const std::vector<size_t>& _layersizes)
 		{
 			size_t _Prevsz = _layersizes[I-1];
 
@@ -135,7 +147,7 @@ namespace artificial_neural_networks
 		}
 
 		template <>
-		void _load<tuple_size_type::value>(std::ifstream& fin, const std::vector<size_t>& _layersizes) 
+		void _load<tuple_size_type::value>(std::istream& fin, const std::vector<size_t>& _layersizes) 
 		{}
 
 	private:
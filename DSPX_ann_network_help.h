@@ -9,34 +9,117 @@ namespace artificial_neural_networks
 	// help fnctions to test and train neural networks...
 
 
-	template <class _NetworkType> inline 
-		real_type network_test_single(_NetworkType& _Net, const real_vector_type& _In)
+	template <class _NetworkType, class T> inline 
+		T network_test_single(_NetworkType& _Net, const std::vector<T>& _In)
 	{
 		return _Net.test_single(_In.cbegin(), _In.cend());
 	}
 
+	template <class _NetworkType, class T> inline 
+		T network_test_single(_NetworkType& _Net, const T* _Beg, const T* _End)
+	{// contiguous input, e.g. the window of a ring
+		return _Net.test_single(_Beg, _End);
+	}
 
-	template <class _NetworkType> inline 
-		void network_train_single(
-				_NetworkType& _Net, const real_vector_type& _In,
-					real_type _Err, const real_type& _MaxErr, const real_type& _MinErr,
-						const real_type& _sdActual)
+
+	enum training_status { training_converged, training_budget_exhausted, training_diverged };
+
+	struct training_budget
+	{// limits of one training: iterations (0: unbounded) and/or a deadline; 
+		// diverged once the error grows above the starting one for _MaxRising passes in a row (0: non finite errors only)
+
+		typedef std::chrono::steady_clock		clock_type;
+
+		training_budget(const size_t& _It=0, const clock_type::time_point& _Dl=clock_type::time_point::max(), const size_t& _Rising=8)
+			: _MaxIterations(_It)
+			, _Deadline(_Dl)
+			, _MaxRising(_Rising)
+		{}
+
+		bool exhausted(const size_t& _Iterations) const
+		{
+			if (_MaxIterations && _Iterations >= _MaxIterations) return true;
+
+			return _Deadline != clock_type::time_point::max() && clock_type::now() >= _Deadline;
+		}
+
+		bool diverged(const size_t& _Rising) const { return _MaxRising && _Rising >= _MaxRising; }
+
+		size_t						_MaxIterations;
+		clock_type::time_point		_Deadline;
+		size_t						_MaxRising;
+	};
+
+
+	template <class _NetworkType, class T> inline 
+		auto network_train_single(
+				_NetworkType& _Net, const T* _Beg, const T* _End,
+					T _Err, const T& _MaxErr, const T& _MinErr,
+						const T& _sdActual, const training_budget& _Budget, size_t& _Iterations) ->training_status
 	{
+		// retrain until the error is within _MinErr, if _MaxErr has been violated; 
+		// stops when _Budget is exhausted, or when the training diverges: the error no longer 
+		// finite, or growing above the starting one for _Budget._MaxRising passes in a row. The weights 
+		// of a diverged training are rolled back to those before this call (train_freeze(), 
+		// copied in place). _Iterations: no. of training passes of this call
+
+		_Iterations = 0;
+
 		if (std::abs(_Err) > _MaxErr)
 		{
 			//cout << _Err << " " << _MaxErr << "\n";		// uncomment for debug
 
+			const T _Start(std::abs(_Err));
+
+			T _Last(_Start);
+
+			size_t _Rising(0); // passes in a row above _Start, none decreasing the error
+
+			_Net.train_freeze(); // the weights before the training
+
 			while (std::abs(_Err) > _MinErr)
 			{
-				_Net.train_single(_In.cbegin(), _In.cend(), &_sdActual);
+				if (_Budget.exhausted(_Iterations)) return training_budget_exhausted;
 
-				real_type _sdNew = _Net.test_single(_In.cbegin(), _In.cend());
+				_Net.train_single(_Beg, _End, &_sdActual);
+
+				++_Iterations;
+
+				T _sdNew = _Net.test_single(_Beg, _End);
 
 				_Err = _sdNew - _sdActual;
+
+				_Rising = (std::abs(_Err) > _Start && std::abs(_Err) >= _Last)? _Rising+1: 0;
+
+				_Last = std::abs(_Err);
+
+				if (!std::isfinite(_Err) || _Budget.diverged(_Rising)) { _Net.train_revert(); return training_diverged; }
 			}
 		}
 
 		//else cout << "no substantial error\n";			// uncomment for debug
+
+		return training_converged;
+	}
+
+	template <class _NetworkType, class T> inline 
+		auto network_train_single(
+				_NetworkType& _Net, const std::vector<T>& _In,
+					T _Err, const T& _MaxErr, const T& _MinErr,
+						const T& _sdActual, const training_budget& _Budget, size_t& _Iterations) ->training_status
+	{
+		return network_train_single(_Net, _In.empty()? 0: &_In[0], _In.empty()? 0: &_In[0] + _In.size(), 
+			_Err, _MaxErr, _MinErr, _sdActual, _Budget, _Iterations);
 	}
 
-}
\ No newline at end of file
+	template <class _NetworkType, class T> inline 
+		void network_train_single(
+				_NetworkType& _Net, const std::vector<T>& _In,
+					T _Err, const T& _MaxErr, const T& _MinErr,
+						const T& _sdActual)
+	{// unbounded
+		size_t _Iterations(0);
+
+		network_train_single(_Net, _In, _Err, _MaxErr, _MinErr, _sdActual, training_budget(), _Iterations);
+	}
+}
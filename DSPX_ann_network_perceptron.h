@@ -14,20 +14,22 @@ namespace artificial_neural_networks
 	class general_multi_layer_perceptron /*undef*/; // general multilayer perceptron class
 
 
-	template <class _Functype, 
+	template <class _Functype, class T,
 		template <class> class... _LayerTypes>
-	class general_multi_layer_perceptron <_Functype, input_layer, _LayerTypes...>
-		: public network<input_layer, _LayerTypes<_Functype>...>
+	class general_multi_layer_perceptron <_Functype, input_layer_t<T>, _LayerTypes...>
+		: public network<input_layer_t<T>, _LayerTypes<_Functype>...>
 	{
 		// specialize general MLP with standard raw input_layer copier,
-		// retain parametric polymorphism for activation function, hidden and output layer typenames
+		// retain parametric polymorphism for activation function, hidden and output layer typenames;
+		// T, the scalar type of the input layer, matches _Functype::value_type
 
 		typedef network_type					base;
 
 	public:
 
+		typedef T								value_type;
 		typedef _Functype						function_type;
-		typedef input_layer						input_layer_type;
+		typedef input_layer_t<T>				input_layer_type;
 		typedef perceptron_layer<_Functype>		perceptron_layer_type;
 		typedef output_layer<_Functype>			output_layer_type;
 
@@ -36,6 +38,7 @@ namespace artificial_neural_networks
 		general_multi_layer_perceptron(_Sizes... _Sz)
 			: base(_Sz...)
 			, _training_pass(0)
+			, _frozen_pass(0)
 		{
 			_initialize();
 		}
@@ -68,13 +71,13 @@ namespace artificial_neural_networks
 		}
 
 		template <class _InIt>
-		typename _InIt::value_type
+		typename std::iterator_traits<_InIt>::value_type
 			test_single(const _InIt& _Beg, const _InIt& _End)
-		{// test single range
+		{// test single range, iterators or pointers
 
 			_RSfeed(_Beg, _End);
 
-			real_type val(0);
+			value_type val(0);
 
 			_output_layer().output(&val);
 
@@ -91,6 +94,14 @@ namespace artificial_neural_networks
 		}
 
 
+		void train_freeze() 
+		{// copy the weights train_revert() returns to, no allocation after the first call
+			_RSfreeze(); _frozen_pass=_training_pass;
+		}
+
+		void train_revert() { _RSrevert(); _training_pass=_frozen_pass; }
+
+
 		auto training_patterns() const ->size_t { return _training_pass; }
 
 		void reset_training_patterns() { _training_pass=0; }
@@ -102,6 +113,36 @@ namespace artificial_neural_networks
 
 		void save(const path_type& P) const {_save(P);}
 
+		void write(std::ostream& s) const
+		{// binary state: layers, learning rate, training passes (see read())
+			_write(s);
+
+			const real_type _Lr(get_learning_rate());
+
+			s.write(reinterpret_cast<const char*>(&_Lr), sizeof(real_type));
+
+			const std::uint64_t _Passes(_training_pass); // portable across 32/64 bit builds
+
+			s.write(reinterpret_cast<const char*>(&_Passes), sizeof(_Passes));
+		}
+
+		bool read(std::istream& s)
+		{// the state of write(), the layer sizes included
+			if (!_read(s)) return false;
+
+			real_type _Lr(0);
+
+			s.read(reinterpret_cast<char*>(&_Lr), sizeof(real_type));
+
+			std::uint64_t _Passes(0);
+
+			s.read(reinterpret_cast<char*>(&_Passes), sizeof(_Passes));
+
+			_training_pass = size_t(_Passes); _RSset_learning_rate(_Lr);
+
+			return s.good();
+		}
+
 		void dump(const path_type& P) const
 		{
 			_dump(P);
@@ -181,6 +222,40 @@ namespace artificial_neural_networks
 		void _backpropagate<0> () {/*stop recursion*/ }
 
 
+		void _RSfreeze()
+		{
+			// start parametric recursion, the input layer holds no weights
+			_freeze<1>();
+		}
+
+		template <size_t I>
+		void _freeze()
+		{
+			_layer<I>().train_freeze();
+
+			_freeze<I+1>();
+		}
+
+		template <>
+		void _freeze<tuple_size_type::value>() {/*stop recursion*/}
+
+		void _RSrevert()
+		{
+			_revert<1>();
+		}
+
+		template <size_t I>
+		void _revert()
+		{
+			_layer<I>().train_revert();
+
+			_revert<I+1>();
+		}
+
+		template <>
+		void _revert<tuple_size_type::value>() {/*stop recursion*/}
+
+
 		void _RSset_learning_rate(const real_type& LR)
 		{
 			// start backward recursion
@@ -203,6 +278,7 @@ namespace artificial_neural_networks
 
 
 		size_t _training_pass;	// number of training steps done
+		size_t _frozen_pass;	// ... at train_freeze()
 	};
 }
 
@@ -15,24 +15,23 @@ namespace artificial_neural_networks
 			_UninitializedRand(_Cont, _Sz, _m, _M);
 		}
 
-		static void initialize(real_type& _Val, const real_type& _m, const real_type& _M)
+		template <class T>
+		static void initialize(T& _Val, const real_type& _m, const real_type& _M)
 		{
 			_UninitializedRand(_Val, _m, _M);
 		}
 	};
 
 	template <class T/*value type*/, class _InitFunc /*activation functor*/>
-	class neuron_t /*undefined*/; // base template for artificial neurons
-
-	template <class _InitFunc>
-	class neuron_t <real_type, _InitFunc>
+	class neuron_t
 	{
-		// template specialization for real_type
+		// base template for artificial neurons, T is real_type or float
 
 	public:
 
 		typedef unsigned char									byte;
-		typedef real_vector_type								weights_container;		// store weights
+		typedef T												value_type;
+		typedef std::vector<T>									weights_container;		// store weights
 		typedef typename weights_container::const_iterator		weights_const_iterator;
 		typedef typename weights_container::iterator			weights_iterator;
 		typedef typename weights_container::reverse_iterator	weights_reverse_iterator;
@@ -40,13 +39,14 @@ namespace artificial_neural_networks
 
 		neuron_t() 
 		: _biasv(0)
+		, _frozenbias(0)
 		{}
 
 		~ neuron_t() {}
 
 
 
-		virtual auto output() const->real_type =0;
+		virtual auto output() const->T =0;
 
 
 		// initialize weights
@@ -56,6 +56,14 @@ namespace artificial_neural_networks
 		void weights_initialize(size_t sz, const real_type& _m, const real_type& _M) { _InitFunc::initialize(_weights, sz, _m, _M); }
 
 
+		// training rollback, see layer::train_freeze(): the frozen copy keeps its capacity, 
+		// no allocation after the first freeze
+
+		void weights_freeze() { _frozen.assign(_weights.cbegin(), _weights.cend()); _frozenbias=_biasv; }
+
+		void weights_revert() { _weights.assign(_frozen.cbegin(), _frozen.cend()); _biasv=_frozenbias; }
+
+
 		// dump
 
 		void dump_weights(std::ostream& s, char _Endl='\n') const
@@ -71,9 +79,9 @@ namespace artificial_neural_networks
 
 		void dump_bias(std::ostream& s, char _Endl='\n') const { s << _biasv << _Endl; }
 		
-		void binary_write(std::ofstream& fout) const
+		void binary_write(std::ostream& fout) const
 		{
-			static const size_t _Frsz(sizeof(real_type));
+			static const size_t _Frsz(sizeof(T));
 
 			for (size_t i=0, e=_weights_size(); i<e; ++i)
 			{
@@ -87,11 +95,11 @@ namespace artificial_neural_networks
 			fout.write(ptr, _Frsz);
 		}
 
-		bool binary_read(std::ifstream& fin, const size_t& n)
+		bool binary_read(std::istream& fin, const size_t& n)
 		{
 			_weights.clear(); _weights.resize(n);
 
-			static const size_t _Frsz(sizeof(real_type));
+			static const size_t _Frsz(sizeof(T));
 
 			for (size_t i=0; i<n; ++i)
 			{
@@ -112,9 +120,9 @@ namespace artificial_neural_networks
 
 		auto _weights_size() const ->size_t { return _weights.size(); }
 
-		auto _weights_at(size_t i) const ->const real_type&{ return _weights[i]; }
+		auto _weights_at(size_t i) const ->const T&{ return _weights[i]; }
 
-		auto _weights_at(size_t i) ->real_type& { return _weights[i]; }
+		auto _weights_at(size_t i) ->T& { return _weights[i]; }
 
 		auto _weights_cbegin() const ->weights_const_iterator { return _weights.cbegin(); }
 
@@ -124,15 +132,18 @@ namespace artificial_neural_networks
 
 		auto _weights_end() ->weights_iterator { return _weights.end(); }
 
-		auto _bias() const ->const real_type&{ return _biasv; }
+		auto _bias() const ->const T&{ return _biasv; }
 
-		auto _bias() ->real_type& { return _biasv; }
+		auto _bias() ->T& { return _biasv; }
 
 
 	private:
 
-		real_type				_biasv;
+		T						_biasv;
 		weights_container		_weights;
+
+		T						_frozenbias;	// weights_freeze() copy
+		weights_container		_frozen;		// ...
 	};
 
 
@@ -9,44 +9,48 @@ namespace artificial_neural_networks
 {
 
 	template <class _ActivFunc>
-	class output_neuron : public perceptron_base
+	class output_neuron : public perceptron_base_t<typename _ActivFunc::value_type>
 	{// output neurons
 
+		typedef perceptron_base_t<typename _ActivFunc::value_type>	base;
+
 	public:
 
+		typedef typename _ActivFunc::value_type						value_type;
+
 		output_neuron()	{}
 
 		~output_neuron() {}
 
 
-		void initialize(size_t _Sz) { perceptron_base::_initialize(0.1, 0.9, _Sz); }
+		void initialize(size_t _Sz) { base::_initialize(0.1, 0.9, _Sz); }
 
-		virtual auto output() const->real_type	{ return _ActivFunc::execute(_prod); }
+		virtual auto output() const->value_type	{ return _ActivFunc::execute(_prod); }
 
-		virtual auto output_delta(const real_type& _Outp, const real_type& _Error) ->real_type
+		virtual auto output_delta(const value_type& _Outp, const value_type& _Error) ->value_type
 		{
-			real_type _der = _ActivFunc::derivative(_Outp);
+			value_type _der = _ActivFunc::derivative(_Outp);
 
 			// find delta
-			real_type _Delta(_Error * _der);
+			value_type _Delta(_Error * _der);
 
 			return _Delta;
 		}
 
 		template <class _LayerType>
-		void back_propagate(const real_type& _Desired, _LayerType& _L, const size_t& trainings, bool _Bdebug=false)
+		void back_propagate(const value_type& _Desired, _LayerType& _L, const size_t& trainings, bool _Bdebug=false)
 		{
 			// calculate sigmoid of the product
-			real_type _Outp(output());
+			value_type _Outp(output());
 
 			// error for this output neuron
-			real_type _Error =(_Desired - _Outp);
+			value_type _Error =(_Desired - _Outp);
 
-			real_type deltaI(output_delta(_Outp, _Error));
+			value_type deltaI(output_delta(_Outp, _Error));
 
 
 			// learning rate ?
-			real_type LR = _learning_rate(trainings);
+			value_type LR = _learning_rate(trainings);
 
 			for (auto WI= _weights_begin(), XI = _inputV.begin(), WE=_weights_end(); WI!=WE; ++WI, ++XI)
 			{
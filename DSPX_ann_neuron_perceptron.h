@@ -8,11 +8,12 @@
 
 namespace artificial_neural_networks
 {
-	struct perceptron_base : public real_random_initializer_neuron
+	template <class T>
+	struct perceptron_base_t : public neuron_t<T, random_initializer>
 	{
-		perceptron_base() : _lr(0.9), _prod(0) {}
+		perceptron_base_t() : _lr(T(0.9)), _prod(0) {}
 
-		~perceptron_base() {}
+		~perceptron_base_t() {}
 
 
 		bool load(std::istream& s)
@@ -54,8 +55,7 @@ namespace artificial_neural_networks
 			_prod = _bias() + dot_product(_inputV.cbegin(), _inputV.cend(), _weights_cbegin());
 		}
 
-		template <>
-		void feed <input_layer>(const input_layer& _L)
+		void feed(const input_layer_t<T>& _L)
 		{
 			// feed coming from a raw-input layer
 			_inputV.clear(); _inputV.resize(_L.size());
@@ -65,10 +65,10 @@ namespace artificial_neural_networks
 			_prod = _bias() + dot_product(_inputV.cbegin(), _inputV.cend(), _weights_cbegin());
 		}
 
-		real_type _learning_rate(const size_t& trainings) const { return _lr; } 
+		T _learning_rate(const size_t& trainings) const { return _lr; } 
 
 
-		void set_learning_rate(const real_type& LR) { _lr=LR; }
+		void set_learning_rate(const real_type& LR) { _lr=static_cast<T>(LR); }
 	
 		auto get_learning_rate() const ->real_type { return _lr; }
 
@@ -88,24 +88,26 @@ namespace artificial_neural_networks
 			bias_initialize(_m, _M);
 		}
 
-		real_type				_lr;
-		real_type				_prod;		// the dot product, calculated on input feed
-		real_vector_type		_inputV;	// store input values temporarily
+		T						_lr;
+		T						_prod;		// the dot product, calculated on input feed
+		std::vector<T>			_inputV;	// store input values temporarily
 	};
 
+	typedef perceptron_base_t<real_type>	perceptron_base;
+
 	template <class _ActivFunc>
 	struct weight_initializator /*undef*/;
 
-	template <>
-	struct weight_initializator <logistic> : public perceptron_base
+	template <class T>
+	struct weight_initializator <logistic_t<T>> : public perceptron_base_t<T>
 	{
-		void initialize(const size_t& _Sz) { perceptron_base::_initialize(0.1, 0.9, _Sz); }
+		void initialize(const size_t& _Sz) { perceptron_base_t<T>::_initialize(0.1, 0.9, _Sz); }
 	};
 
-	template <>
-	struct weight_initializator <hyperbolic_tangent> : public perceptron_base
+	template <class T>
+	struct weight_initializator <hyperbolic_tangent_t<T>> : public perceptron_base_t<T>
 	{
-		void initialize(const size_t& _Sz) { perceptron_base::_initialize(-0.9, 0.9, _Sz); }
+		void initialize(const size_t& _Sz) { perceptron_base_t<T>::_initialize(-0.9, 0.9, _Sz); }
 	};
 
 	template <class _ActivFunc>
@@ -115,31 +117,33 @@ namespace artificial_neural_networks
 		
 
 	public:
+
+		typedef typename _ActivFunc::value_type		value_type;
 			
 		perceptron() {}
 
-		perceptron(const perceptron&) {}
+		perceptron(const perceptron& _P) : weight_initializator<_ActivFunc>(_P) {} // weights included, see predictor_spec::update_async()
 
 		~perceptron() {}
 
 
-		auto output() const->real_type
+		auto output() const->value_type
 		{
 			// activation func call
 			return _ActivFunc::execute(_prod);
 		}
 
-		auto output_delta(const real_type& _Outp, const real_type& _SumDeltas) const ->real_type
+		auto output_delta(const value_type& _Outp, const value_type& _SumDeltas) const ->value_type
 		{
-			real_type _der = _ActivFunc::derivative(_Outp);
+			value_type _der = _ActivFunc::derivative(_Outp);
 
 			// find delta
-			real_type _Delta(_SumDeltas * _der);
+			value_type _Delta(_SumDeltas * _der);
 
 			return _Delta;
 		}
 
-		void push_back_propagate(const real_type& _UpperDelta)
+		void push_back_propagate(const value_type& _UpperDelta)
 		{
 			// push upper layer deltas
 			_deltas.push_back(_UpperDelta);
@@ -149,16 +153,16 @@ namespace artificial_neural_networks
 		void back_propagate(_LayerType& _L, const size_t& trainings)
 		{
 			// sum accumulated deltas from upper layer
-			real_type _SUMdelta(sum(_deltas.begin(), _deltas.end()));
+			value_type _SUMdelta(sum(_deltas.begin(), _deltas.end()));
 
 			// calculate sigmoid of the product
-			real_type _Outp(output());
+			value_type _Outp(output());
 
 			// execute derivative of sigmoid
-			real_type deltaI = output_delta(_Outp, _SUMdelta);
+			value_type deltaI = output_delta(_Outp, _SUMdelta);
 
 			// learning rate ?
-			real_type LR = _learning_rate(trainings); 
+			value_type LR = _learning_rate(trainings); 
 
 			// update weights
 			for (auto WI= _weights_begin(), XI = _inputV.begin(), WE=_weights_end(); WI!=WE; ++WI, ++XI)
@@ -185,20 +189,20 @@ namespace artificial_neural_networks
 			_deltas.clear();
 		}
 
-		template <>
-		void back_propagate <input_layer> (input_layer& _L, const size_t& trainings)
-		{
+		void back_propagate(input_layer_t<value_type>& _L, const size_t& trainings)
+		{// raw-input layer, nothing to propagate to
+
 			// sum accumulated deltas from upper layer
-			real_type _SUMdelta(sum(_deltas.begin(), _deltas.end()));
+			value_type _SUMdelta(sum(_deltas.begin(), _deltas.end()));
 
 			// calculate sigmoid of the product
-			real_type _Outp(output());
+			value_type _Outp(output());
 
 			// execute derivative of sigmoid
-			real_type deltaI = output_delta(_Outp, _SUMdelta);
+			value_type deltaI = output_delta(_Outp, _SUMdelta);
 
 			// learning rate ?
-			real_type LR = _learning_rate(trainings);
+			value_type LR = _learning_rate(trainings);
 
 			// update weights
 			for (auto WI= _weights_begin(), XI = _inputV.begin(), WE=_weights_end(); WI!=WE; ++WI, ++XI)
@@ -218,7 +222,7 @@ namespace artificial_neural_networks
 
 	private:
 
-		real_vector_type		_deltas;	// upper layer backpropagation factors
+		std::vector<value_type>	_deltas;	// upper layer backpropagation factors
 	};
 }
 
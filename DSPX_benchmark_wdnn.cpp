@@ -20,8 +20,13 @@
 #include "DSPX_financial_convert.h"
 #include "DSPX_financial_bar.h"
 #include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
 #include "DSPX_fast_wavelet_transform.h"
 #include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
 #include "DSPX_engine.h"
 
 #define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
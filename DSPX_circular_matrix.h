@@ -0,0 +1,314 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// fixed capacity circular storage of matrix Q rows
+
+#pragma once
+
+
+namespace fast_wavelet_transform
+{
+	template <class T>
+	class circular_matrix
+	{
+		// fixed capacity circular buffer of rows, held in one contiguous allocation.
+		// rows are addressed by logical age: [0] is the oldest row, [size()-1] the newest.
+		// operator[] returns a row pointer, so that _M[r][c] reads as with a vector of vectors.
+
+	public:
+
+		typedef T									value_type;
+		typedef value_type*							pointer;
+		typedef const value_type*					const_pointer;
+
+
+		circular_matrix()
+			: _Cap(0)
+			, _Cols(0)
+			, _Head(0)
+			, _Size(0)
+			, _Appended(0)
+			, _Data()
+		{}
+
+		circular_matrix(const size_t& _Capacity, const size_t& _Columns)
+			: _Cap(_Capacity)
+			, _Cols(_Columns)
+			, _Head(0)
+			, _Size(0)
+			, _Appended(0)
+			, _Data(_Capacity*_Columns) // the only allocation
+		{}
+
+		~circular_matrix() {}
+
+
+		void reset(const size_t& _Capacity, const size_t& _Columns)
+		{// reallocate and empty
+			_Cap=_Capacity; _Cols=_Columns; _Head=_Size=0; _Appended+=_Cap+1;
+
+			_Data.assign(_Cap*_Cols, value_type(0));
+		}
+
+		auto size() const ->size_t { return _Size; }		// no. of rows stored
+
+		auto capacity() const ->size_t { return _Cap; }		// max no. of rows
+
+		auto columns() const ->size_t { return _Cols; }		// row size
+
+		bool empty() const { return !_Size; }
+
+		bool full() const { return _Size==_Cap; }
+
+		auto appended() const ->size_t { return _Appended; } // rows appended so far, see clear()
+
+
+		pointer operator[] (const size_t& i) { return &_Data[_physical(i)*_Cols]; }
+
+		const_pointer operator[] (const size_t& i) const { return &_Data[_physical(i)*_Cols]; }
+
+		pointer front() { return (*this)[0]; }
+
+		const_pointer front() const { return (*this)[0]; }
+
+		pointer back() { return (*this)[_Size-1]; }
+
+		const_pointer back() const { return (*this)[_Size-1]; }
+
+
+		pointer push_back()
+		{// append a zeroed row; if full, the oldest row is overwritten
+
+			if (full()) pop_front();
+
+			pointer _Row(&_Data[_physical(_Size++)*_Cols]);
+
+			++_Appended;
+
+			std::fill(_Row, _Row+_Cols, value_type(0));
+
+			return _Row;
+		}
+
+		pointer push_back(const const_pointer& _Src)
+		{// append a copy of the row at _Src; if full, the oldest row is overwritten
+
+			if (full()) pop_front();
+
+			pointer _Row(&_Data[_physical(_Size++)*_Cols]);
+
+			++_Appended;
+
+			std::copy(_Src, _Src+_Cols, _Row);
+
+			return _Row;
+		}
+
+		void pop_front()
+		{// discard the oldest row
+			if (++_Head==_Cap) _Head=0;
+
+			--_Size;
+		}
+
+		// discard all the rows: appended() jumps past the capacity, so that a reader caching 
+		// the rows appended since a given count (see predictor_spec) finds them all replaced
+
+		void clear() { _Head=_Size=0; _Appended+=_Cap+1; }
+
+
+		void write(std::ostream& s) const
+		{// binary: no. of rows, then the rows from the oldest
+			const std::uint64_t _Rows(_Size); // portable across 32/64 bit builds
+
+			s.write(reinterpret_cast<const char*>(&_Rows), sizeof(_Rows));
+
+			for (size_t i=0; i<_Size; ++i) s.write(reinterpret_cast<const char*>((*this)[i]), _Cols*sizeof(value_type));
+		}
+
+		bool read(std::istream& s)
+		{// the rows of write(), same columns; false if they exceed the capacity
+			std::uint64_t _Rows(0);
+
+			s.read(reinterpret_cast<char*>(&_Rows), sizeof(_Rows));
+
+			if (!s.good() || _Rows>_Cap) return false;
+
+			clear();
+
+			for (std::uint64_t i=0; i<_Rows; ++i) s.read(reinterpret_cast<char*>(push_back()), _Cols*sizeof(value_type));
+
+			return s.good();
+		}
+
+	private:
+
+		auto _physical(const size_t& i) const ->size_t
+		{// logical age to physical row, no modulo
+			const size_t k(_Head+i);
+
+			return (k<_Cap)? k: k-_Cap;
+		}
+
+
+		size_t						_Cap;		// row capacity
+		size_t						_Cols;		// row size
+		size_t						_Head;		// physical index of the oldest row
+		size_t						_Size;		// no. of rows stored
+		size_t						_Appended;	// no. of push_back(), see clear()
+		std::vector<value_type>		_Data;		// contiguous storage
+	};
+
+
+	template <class T>
+	class timeline_matrix : public circular_matrix<T>
+	{
+		// circular_matrix that also keeps some columns column major (coefficient timelines): 
+		// for each tracked column the depth() newest values, contiguous, oldest first.
+		// The rows serve the theorem copies, the timelines the readers of the history of 
+		// a coefficient (see predictor_spec). A row enters the timelines when it is complete:
+		// push_back(_Src), or push_back() then commit_back() once it is written
+
+		typedef circular_matrix<T>						base;
+
+	public:
+
+		typedef typename base::value_type				value_type;
+		typedef typename base::pointer					pointer;
+		typedef typename base::const_pointer			const_pointer;
+
+
+		timeline_matrix()
+			: base()
+			, _Depth(0)
+			, _Pos(0)
+			, _Count(0)
+			, _Tracked()
+			, _Slots()
+			, _Lines()
+		{}
+
+		timeline_matrix(const size_t& _Capacity, const size_t& _Columns)
+			: base(_Capacity, _Columns)
+			, _Depth(0)
+			, _Pos(0)
+			, _Count(0)
+			, _Tracked()
+			, _Slots()
+			, _Lines()
+		{}
+
+		~timeline_matrix() {}
+
+
+		void track(const std::vector<size_t>& _Columns /*none: row major only*/, const size_t& _D)
+		{// timelines of _Columns, _D values each, filled from the rows stored
+
+			_Tracked = _Columns; _Depth = _Columns.empty()? 0: _D;
+
+			_Slots.assign(_Columns.empty()? 0: base::columns(), _Untracked);
+
+			for (size_t k = 0; k < _Tracked.size(); ++k) _Slots.at(_Tracked[k]) = k;
+
+			_Lines.assign(_Tracked.size()*2*_Depth, value_type(0));
+
+			_rebuild();
+		}
+
+		bool tracked() const { return _Depth != 0; }
+
+		auto depth() const ->size_t { return _Depth; } // values of a timeline
+
+		const_pointer timeline(const size_t& c) const
+		{// depth() newest values of column c, oldest first; 0 if untracked, or not yet depth() rows
+			if (c >= _Slots.size() || _Slots[c] == _Untracked || _Count < _Depth) return 0;
+
+			return &_Lines[_Slots[c]*2*_Depth + _Pos]; // _Pos: the slot next overwritten, the oldest
+		}
+
+
+		pointer push_back() { return base::push_back(); } // zeroed, see commit_back()
+
+		pointer push_back(const const_pointer& _Src)
+		{
+			pointer _Row(base::push_back(_Src));
+
+			commit_back();
+
+			return _Row;
+		}
+
+		void commit_back()
+		{// the newest row into the timelines, once
+
+			if (!tracked()) return;
+
+			const const_pointer _Row(base::back());
+
+			for (size_t k = 0; k < _Tracked.size(); ++k)
+			{
+				const pointer _L(&_Lines[k*2*_Depth]);
+
+				_L[_Pos] = _Row[_Tracked[k]]; _L[_Pos + _Depth] = _Row[_Tracked[k]]; // mirrored
+			}
+
+			if (++_Pos == _Depth) _Pos = 0;
+
+			if (_Count < _Depth) ++_Count;
+		}
+
+		void clear() { base::clear(); _Pos = _Count = 0; }
+
+		void reset(const size_t& _Capacity, const size_t& _Columns) 
+		{// untracks all
+			base::reset(_Capacity, _Columns); 
+			
+			track(std::vector<size_t>(), 0);
+		}
+
+		bool read(std::istream& s)
+		{
+			const bool _Good(base::read(s));
+
+			_rebuild();
+
+			return _Good;
+		}
+
+	private:
+
+		enum : size_t {_Untracked = size_t(-1)};	// timeline of an untracked column
+
+		void _rebuild()
+		{// the timelines from the newest rows
+			_Pos = _Count = 0;
+
+			if (!tracked()) return;
+
+			for (size_t r = (base::size() > _Depth? base::size() - _Depth: 0); r < base::size(); ++r)
+			{
+				const const_pointer _Row((*this)[r]);
+
+				for (size_t k = 0; k < _Tracked.size(); ++k)
+				{
+					const pointer _L(&_Lines[k*2*_Depth]);
+
+					_L[_Pos] = _Row[_Tracked[k]]; _L[_Pos + _Depth] = _Row[_Tracked[k]];
+				}
+
+				if (++_Pos == _Depth) _Pos = 0;
+
+				++_Count;
+			}
+		}
+
+
+		size_t						_Depth;		// values of a timeline
+		size_t						_Pos;		// slot next overwritten, all the timelines
+		size_t						_Count;		// slots filled
+		std::vector<size_t>			_Tracked;	// columns, by timeline
+		std::vector<size_t>			_Slots;		// timeline of each column, or _Untracked
+		std::vector<value_type>		_Lines;		// timelines, 2*_Depth values each (mirrored ring)
+	};
+}
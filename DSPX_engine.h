@@ -6,6 +6,10 @@
 #pragma once
 #define M01 "theorem failed, not enough history dwts"
 #define M02 "neuralnet failed, not enough history dwts"
+#define M03 "engine failed, no pending forecast"
+#define M04 "snapshot failed, not an engine snapshot of this version"
+#define M05 "snapshot failed, engine configuration mismatch"
+#define M06 "snapshot failed, stream error"
 
 // 
 // FWT assisted inference engine for streaming datasets
@@ -20,43 +24,38 @@ namespace predictor_system
 
 	typedef fwt::shift_variance_theorem								shift_variance_theorem;
 
-	typedef ann::general_multi_layer_perceptron<
-			ann::hyperbolic_tangent, ann::input_layer, 
+	template <class T>
+	using m1lp_t = ann::general_multi_layer_perceptron<
+			ann::hyperbolic_tangent_t<T>, ann::input_layer_t<T>, 
 				ann::perceptron_layer, 
-					ann::output_layer>								m1lp_type; // single hidden layer MLP
+					ann::output_layer>;										// single hidden layer MLP of scalar T
 
-	typedef ann::general_multi_layer_perceptron<
-			ann::hyperbolic_tangent, ann::input_layer, 
+	template <class T>
+	using m3lp_t = ann::general_multi_layer_perceptron<
+			ann::hyperbolic_tangent_t<T>, ann::input_layer_t<T>, 
 				ann::perceptron_layer, 
 				ann::perceptron_layer, 
 				ann::perceptron_layer, 
-					ann::output_layer>								m3lp_type; // triple hidden layer MLP
+					ann::output_layer>;										// triple hidden layer MLP of scalar T
 
-	template <class matrix_type>
-	class predictor
-	{// abstract class for virtual predictors
-
-	protected:
-
-		typedef typename matrix_type::value_type::value_type		value_type;
-
-	public:
-
-		virtual ~predictor() {}
-
-		virtual auto predict(const matrix_type& _M, size_t i) ->value_type = 0;
-
-		virtual void update(const matrix_type& _M, size_t i) = 0;
-	};
+	typedef m1lp_t<real_type>										m1lp_type; // single hidden layer MLP
+	typedef m3lp_t<real_type>										m3lp_type; // triple hidden layer MLP
 
 	namespace /*...predictors*/
 	{
+		// a kind of predictor is a specialization of predictor_spec, its predictors are held by 
+		// the predictor_group of the same kind: contiguous, each phase one non-virtual batch call
+
 		template <class matrix_type,  class _PredictorT>
 		class predictor_spec /*undef*/;
 
 		template <class matrix_type>
-		class predictor_spec <matrix_type, m1lp_type> : public predictor <matrix_type>
-		{// specialization for single hidden layer perceptron networks
+		class predictor_spec <matrix_type, m1lp_t<typename matrix_type::value_type>>
+		{// specialization for single hidden layer perceptron networks, of the scalar type of matrix Q
+
+			typedef typename matrix_type::value_type				value_type;
+			typedef m1lp_t<value_type>								network_type;
+			typedef typename network_type::function_type			function_type;
 
 		public:
 
@@ -66,15 +65,36 @@ namespace predictor_system
 				, _Last_sdFcst(0.0)
 				, _MaxErr(0)	// lazy set
 				, _MinErr(0)	// ...
+				, _Diffs(2*_mlp.input_size())
+				, _DiffPos(0)
+				, _Synced(0)
+				, _DiffValid(false)
+				, _Iterations(0)
+				, _Shadow()		// update_async() allocates it
+				, _State(_idle)
+				, _JobMx()
+				, _JobDone()
+				, _Async(false)
+				, _Trained(0)
+				, _JobTick(0)
+				, _jinput(_mlp.input_size())
+				, _jErr(0)
+				, _jActual(0)
+				, _jIterations(0)
 			{
 			}
 
-			~predictor_spec() {}
+			~predictor_spec() 
+			{// a background training owns _Shadow until it returns
+				std::unique_lock<std::mutex> _L(_JobMx);
+
+				_JobDone.wait(_L, [this] { return _State != _busy; });
+			}
 
 
 			void set_mlp_learningrate(const value_type& _Lrate) 
 			{// set mlp learning rate param
-				_mlp.set_learning_rate(_Lrate);
+				_mlp.set_learning_rate(_Lrate); if (_Shadow) _Shadow->set_learning_rate(_Lrate);
 			}
 
 			void set_mlp_mM_errors(const value_type& M, const value_type& m) 
@@ -82,448 +102,1668 @@ namespace predictor_system
 				_MaxErr=M; _MinErr =m;
 			}
 
-			virtual auto predict /*throws*/(const matrix_type& _M, size_t i) ->value_type
+			auto predict /*throws*/(const matrix_type& _M, size_t i) ->value_type
 			{// use first differences			
 
-				// cache hist and input sizes
-				const size_t _history_size(_M.size()), _input_size(_mlp.input_size());
-
-				// precheck this...
-				if (_input_size + 1 > _history_size) throw std::exception(M02);
-
-				// find indeces...
-				const size_t _vecbeg(_history_size - _input_size), _vecend(_history_size);
-
-				// allocate input for first differences of the source series
-				std::vector<value_type> _dinput(_input_size);
-
-				// extract first differences
-				for (size_t z=0, vi=_vecbeg, ve=_vecend; vi<ve; ++vi, ++z) _dinput[z] = _M[vi][i] - _M[vi - 1][i];
+				// first differences of the source series (precheck included)
+				const value_type* _In(_first_differences(_M, i));
 				
 				// test mlp with input
-				const value_type _sdFcst = network_test_single(_mlp, _dinput);
+				const value_type _sdFcst = network_test_single(_mlp, _In, _In + _mlp.input_size());
 
 				// invert sigmoid
-				const value_type _dFcst = ann::hyperbolic_tangent::invert(_sdFcst);
+				const value_type _dFcst = function_type::invert(_sdFcst);
 
 				// store last 1stdiff sigmoided result
 				_Last_sdFcst = _sdFcst; // value used in the next update()
 
 				// revert from 1st differences to real value
-				const value_type _Fcst = _dFcst + _M[_vecend - 1][i]; 
+				const value_type* _C(_M.timeline(i)); // column major, if Q keeps it (see timeline_matrix)
+
+				const value_type _Fcst = _dFcst + (_C? _C[_M.depth() - 1]: _M[_M.size() - 1][i]); 
 				
 				return _Fcst;
 			}
 
-			virtual void update(const matrix_type& _M, size_t i)
+			void update(const matrix_type& _M, size_t i)
 			{// last coefficient already updated
 
-				// cache hist and input sizes
-				const size_t _history_size(_M.size()), _input_size(_mlp.input_size());
-				
-				// precheck this...
-				if (_input_size + 1 > _history_size) throw std::exception(M02);
-
-				// find indeces...
-				const size_t _vecbeg(_history_size - _input_size), _vecend(_history_size);
-				
-				// allocate input for first differences of the source series
-				std::vector<value_type> _dinput(_input_size);
+				update(_M, i, ann::training_budget());
+			}
 
-				// extract first differences
-				for (size_t z = 0, vi = _vecbeg, ve = _vecend; vi < ve; ++vi, ++z) _dinput[z] = _M[vi][i] - _M[vi - 1][i];
-				
-				// cache actual last 1st diff value
-				const value_type _dActual(*_dinput.crbegin());
+			auto update(const matrix_type& _M, size_t i, const ann::training_budget& _Budget) ->ann::training_status
+			{// last coefficient already updated, retrain within _Budget
 
-				// get sigmoided actual value
-				const value_type _sdActual = ann::hyperbolic_tangent::execute(_dActual);
+				value_type _sdActual(0);
 
-				// get sigmoided last prediction error 
-				const value_type _Err = _Last_sdFcst - _sdActual;
+				const value_type _Err(_sample(_M, i, _sdActual));
 				
 				// train network if minErr has been violated
-				network_train_single(_mlp, _dinput, _Err, _MaxErr, _MinErr, _sdActual);
-			}
-
+				const ann::training_status _Status(network_train_single(_mlp, _input(), _input() + _mlp.input_size(), _Err, _MaxErr, _MinErr, _sdActual, _Budget, _Iterations));
 
-		private:
+				_Async = false; // _Shadow out of date
 
-			m1lp_type			_mlp;			// neural network
+				return _Status;
+			}
 
-			value_type			_Last_sdFcst;	// depot 
-			value_type			_MaxErr;
-			value_type			_MinErr;
-		};
+			auto pending_error(const matrix_type& _M, size_t i) ->value_type
+			{// |sigmoided error| of the last forecast, if it violates the max error
+				value_type _sdActual(0);
 
-		template <class matrix_type>
-		class predictor_spec <matrix_type, shift_variance_theorem> : public predictor <matrix_type>
-		{// specialization for theorem coefficients transposition
+				const value_type _Err(std::abs(_sample(_M, i, _sdActual)));
 
-		public:
+				return _Err > _MaxErr? _Err: 0;
+			}
 
-			predictor_spec(const shift_variance_theorem& _Th)
-				: _Theorem(_Th)
-			{}
+			auto iterations() const ->size_t { return _Iterations; }
 
-			~predictor_spec() {}
+			void save(std::ostream& s) const
+			{// last forecast, error bounds, network
+				binary_put(s, _Last_sdFcst); binary_put(s, _MaxErr); binary_put(s, _MinErr);
 
+				_mlp.write(s);
+			}
 
-			virtual auto predict /*throws*/(const matrix_type& _M, size_t i) ->value_type
+			bool load(std::istream& s)
 			{
-				const size_t _backsteps(_Theorem.back_steps(i)), _history_size(_M.size());
+				binary_get(s, _Last_sdFcst); binary_get(s, _MaxErr); binary_get(s, _MinErr);
 
-				// precheck this...
-				if (_history_size < _backsteps + 1) throw std::exception(M01);
+				_Async = false; _Iterations = 0; // _Shadow resynchronized by the next update_async()
 
-				// return ritish column transposed coefficient...
-				return _M[_history_size - _backsteps][i + 1];
+				_DiffValid = false; // rebuilt from the loaded matrix Q
+
+				return _mlp.read(s);
 			}
 
-			virtual void update(const matrix_type& _M, size_t i) {/*donothing*/ }
+			void update_async(const matrix_type& _M, size_t i, const size_t& _Tick, background_queue& _Q)
+			{
+				// as update(), but trains the private copy _Shadow on a background thread;
+				// predict() keeps using the published _mlp until publish(). A sample
+				// arriving while a training is in flight is dropped
 
-		private:
+				publish();
 
-			const shift_variance_theorem&			_Theorem;
-		};	
+				if (!_Async) // first one, or back from update()
+				{
+					if (_Shadow) *_Shadow = _mlp; else _Shadow.reset(new network_type(_mlp));
 
-		// develop other predictor_spec here...
-	}
-	
-	template <class matrix_type>
-	class predictor_container
-	{// wrapper object to hold virtual predictor objects
+					_Trained = _Tick; _Async = true;
+				}
 
-		typedef typename matrix_type::value_type::value_type			value_type;
-		typedef predictor <matrix_type>									predictor;
-		typedef predictor_spec<matrix_type, m1lp_type>					neural_predictor_type;
-		typedef predictor_spec<matrix_type, shift_variance_theorem>		theorem_predictor_type;
-		
-		// ... import other predictor_spec specialization types here
+				value_type _sdActual(0);
 
-	public:
+				const value_type _Err(_sample(_M, i, _sdActual));
 
-		typedef predictor												predictor_type;
+				if (std::abs(_Err) <= _MaxErr) { if (_State == _idle) _Trained = _Tick; return; } // nothing to learn
 
+				if (_State != _idle) return; // in flight, the weights fall behind
 
-		predictor_container(const shift_variance_theorem& _Th)
-		{
-			_default_create_predictors(_Th);
-		}
+				// the task owns _Shadow and the job depots until it flags _ready
+				_jinput.assign(_input(), _input() + _mlp.input_size()); _jErr = _Err; _jActual = _sdActual; _JobTick = _Tick;
 
-		~predictor_container()
-		{
-			_destroy_predictors();
-		}
+				_State = _busy;
 
+				_Q.submit([this]
+				{
+					network_train_single(*_Shadow, _jinput, _jErr, _MaxErr, _MinErr, _jActual, ann::training_budget(), _jIterations);
 
-		predictor* operator[] (const size_t& i) const { return _Prd.at(i); }
+					std::lock_guard<std::mutex> _L(_JobMx); // notified under the lock: the destructor may follow
 
-	private:
+					_State = _ready; _JobDone.notify_all();
+				});
+			}
 
-		void _default_create_predictors(const shift_variance_theorem& _Th)
-		{
+			void publish()
+			{// the trained copy replaces the published weights (same thread as predict())
+				if (_State != _ready) return;
 
-			for (size_t i = 0; i < _Th.source_size(); ++i)
+				_mlp = *_Shadow; _Trained = _JobTick; _Iterations = _jIterations;
+
+				_State = _idle;
+			}
+
+			auto staleness(const size_t& _Tick) const ->size_t 
 			{
-				if (_Th.is_SVT_coefficient(i)) _Prd[i] = new theorem_predictor_type(_Th);
+				return _Async? _Tick - _Trained: 0;
+			}
 
-				else // MLP, SOM/SOL, SVM, compound, etc. 
-				{// e.g. Daub4 -> 5 6 7 - 13 14 15 - 29 30 31 - 61 62 63 - 126 127
-					
-					const size_t __NEURALINPUTSIZE = 8;
 
-					neural_predictor_type* ptr = 
-						new neural_predictor_type(__NEURALINPUTSIZE , 2*__NEURALINPUTSIZE , 1);
-						
-					//const value_type _MaxErr(.0001), _MinErr(.00001);
-					const value_type _MaxErr(.01), _MinErr(.000001);
+		private:
 
-					ptr->set_mlp_learningrate(0.1);
+			predictor_spec(const predictor_spec&);	// not copyable, see predictor_group
 
-					ptr->set_mlp_mM_errors(_MaxErr, _MinErr);
+			predictor_spec& operator=(const predictor_spec&);
 
-					_Prd[i] = ptr;
-				}
-			}
-		}
+			enum training_state {_idle, _busy /*background training*/, _ready /*to publish*/};
 
-		void _destroy_predictors()
-		{
-			for (auto I = _Prd.begin(), E = _Prd.end(); I != E; ++I)
-			{
-				safe_delete(I->second);
-			}
-		}
+			auto _sample(const matrix_type& _M, size_t i, value_type& _sdActual) ->value_type
+			{// first differences of the newest input, see _input(), sigmoided actual value; returns the last error
 
+				// extract first differences of the source series
+				const value_type* _In(_first_differences(_M, i));
+				
+				// cache actual last 1st diff value
+				const value_type _dActual(_In[_mlp.input_size() - 1]);
 
-		std::map<size_t, predictor*>		_Prd;		// mapped predictors
-	};
+				// get sigmoided actual value
+				_sdActual = function_type::execute(_dActual);
 
-	template <class FWT_type>
-	class engine
-	{
-		typedef real_type									value_type;
-		typedef real_vector_type							vector_type;
-		typedef real_matrix_type							matrix_type;
+				// get sigmoided last prediction error 
+				return _Last_sdFcst - _sdActual;
+			}
 
-		typedef FWT_type									transformer_type;
-		typedef fwt::shift_variance_theorem					theorem_type;
-		typedef predictor_container<matrix_type>			predictor_container_type;
-		typedef predictor_container_type::predictor_type	predictor_type;
+			auto _first_differences(const matrix_type& _M, size_t i) ->const value_type*
+			{
+				// the input size newest first differences of column i, oldest first. They are kept in a 
+				// ring, mirrored as engine::push() does: one subtraction per row appended to Q since 
+				// the last call, all of them after a warm-up, a snapshot load or a withdrawn row
 
-	public:
+				const size_t _history_size(_M.size()), _input_size(_mlp.input_size());
 
-		engine(const size_t& _DWTInputSz)
-			: _InputSz(_DWTInputSz)
-			, _DWT()
-			, _Theorem(_DWTInputSz, _DWT.size()/2)
-			, _Transforms()
-			, _Forecasts()
-			, _Sources()
-			, _Inverted()
-			, _Predictors(_Theorem) // creates predictors
-			, _Fcst(source_size()) // allocate
-			, _Inv(source_size()) // ...
-		{
+				// precheck this...
+				if (_input_size + 1 > _history_size) throw std::exception(M02);
 
-		}
+				size_t _New(_M.appended() - _Synced);
 
-		~engine()
-		{}
+				if (!_DiffValid || _New > _input_size) _New = _input_size;
 
+				const value_type* _C(_M.timeline(i)); // contiguous history of the column, if Q keeps one
 
-		bool trained() const {return _Forecasts.size()==_Transforms.size();} // predictors trained
+				if (_C && _M.depth() < _New + 1) _C = 0;
 
-		auto source_size() const ->size_t {return _InputSz;}
+				for (size_t b = _New; b > 0; --b) // rows behind the newest, +1
+				{
+					const value_type _D(_C? _C[_M.depth() - b] - _C[_M.depth() - b - 1]: 
+						_M[_history_size - b][i] - _M[_history_size - b - 1][i]);
 
-		auto history_size() const ->size_t {return _Transforms.size();}
+					_Diffs[_DiffPos] = _D; _Diffs[_DiffPos + _input_size] = _D;
 
-		auto minQ_size() const ->size_t {return _InputSz;}
+					if (++_DiffPos == _input_size) _DiffPos = 0;
+				}
 
-		auto predict()->value_type
-		{
-			// perform reduced FWT using the SVT theorem
-			_reduce_predict();
+				_Synced = _M.appended(); _DiffValid = true;
 
-			// get a reference to the crystal
-			vector_type& _Out = *(--_Forecasts.end());
+				return _input();
+			}
 
-			// perform inverse DWT on it
-			_DWT.invert(&_Out[0], &_Inv[0], source_size());
-			
-			// trim excess forecast vector from the storage
-			if (_Forecasts.size() > minQ_size()) _Forecasts.erase(_Forecasts.begin());
-			
-			// store inverse DWT (forecasted series)
-			_Inverted.push_back(_Inv);
+			auto _input() const ->const value_type* {return &_Diffs[_DiffPos];} // newest first differences
 
-			// trim...
-			if (_Inverted.size() > minQ_size()) _Inverted.erase(_Inverted.begin());
-			
-			// return last element of the inverted DWT
-			return *_Inv.crbegin();
-		}
 
-		template <class _Init>
-		auto predict(const _Init& _Beg, const _Init& _End)->value_type
-		{
-			// perform reduced FWT using the SVT theorem
-			_reduce_predict();
+			network_type		_mlp;			// neural network, published weights
 
-			// get a reference to the crystal
-			vector_type& _Out = *(--_Forecasts.end());
+			value_type			_Last_sdFcst;	// depot 
+			value_type			_MaxErr;
+			value_type			_MinErr;
 
-			// optimize crystal 
-			_optimize(_Beg, _End, _Out);
+			std::vector<value_type>	_Diffs;		// first differences of the column, ring mirrored
+			size_t					_DiffPos;	// oldest of them
+			size_t					_Synced;	// appended() of matrix Q the ring reflects
+			bool					_DiffValid;	// ...
+			size_t					_Iterations;	// training passes of the last update
+
+			std::unique_ptr<network_type>	_Shadow;	// private copy, trained in background (async only)
+			std::atomic<training_state>	_State;		// ...
+			std::mutex					_JobMx;		// _State leaving _busy
+			std::condition_variable		_JobDone;	// ...
+			bool						_Async;		// _Shadow in use (last update asynchronous)
+			size_t						_Trained;	// tick of the newest sample the published weights reflect
+			size_t						_JobTick;	// tick of the sample in training
+			std::vector<value_type>		_jinput;	// depots of the background training
+			value_type					_jErr;		// ...
+			value_type					_jActual;	// ...
+			size_t						_jIterations;	// ...
+		};
 
-			// inverse DWT
-			_DWT.invert(&_Out[0], &_Inv[0], source_size());
 
-			// trim excess forecast vector from the storage
-			if (_Forecasts.size() > minQ_size()) _Forecasts.erase(_Forecasts.begin());
-			
-			// store inverse DWT (forecasted series)
-			_Inverted.push_back(_Inv);
+		// develop other predictor_spec here...
 
-			// trim...
-			if (_Inverted.size() > minQ_size()) _Inverted.erase(_Inverted.begin());
-			
-			// return last element of the inverted DWT
-			return *_Inv.crbegin();
-		}
 
-		template <class _Init>
-		auto update(const _Init& _Beg, const _Init& _End)
-		{// push-pop a new value in the source queue, transform and store the new DWT
+		template <class matrix_type, class _PredictorT>
+		class predictor_group
+		{// the predictors of one kind, dense: the member k predicts the coefficient ordinal(k)
 
-			// pattern discrete wavelet transform 
-			_full_transform(_Beg, _End);
-			
-			// not enough history in Q...
-			if (history_size() <= minQ_size()) return;
+			typedef typename matrix_type::value_type				value_type;
+			typedef typename matrix_type::pointer					pointer;
 
-			// trim excess vector in Q front...
-			_Transforms.erase(_Transforms.begin());
+		public:
 
+			typedef predictor_spec<matrix_type, _PredictorT>		spec_type;
+			typedef std::vector<size_t>								selection_type;	// members
+
+			predictor_group()
+				: _Specs()
+				, _Ordinals()
+				, _Pending()
+				, _Lines()
+#ifdef DSPX_LATENCY
+				, _Latency(0)
+#endif
+			{}
 
-			// for each ordinal
-			for (size_t i = 0; i < source_size(); ++i)
-			{
-				// retrieve pointer to predictor
-				predictor_type* ptr = _Predictors[i];
-				
-				// retrain predictor
-				ptr->update(_Transforms, i);
+			void reserve(const size_t& _N)
+			{// capacity, once: the members are never relocated
+				_Specs.reserve(_N); _Ordinals.reserve(_N); _Pending.reserve(_N); _Lines.reserve(_N + 1);
 			}
-		}
 
+			template <class... _Args>
+			auto emplace(const size_t& _Ordinal, _Args&&... _A) ->spec_type&
+			{// new member, constructed in place
+				spec_type& _S = _Specs.emplace_back(std::forward<_Args>(_A)...);
 
-		// diagnostic outputs
+				_Ordinals.push_back(_Ordinal);
 
-		void dump_engine_diagnose(std::ostream& s) const
-		{
-			_dump_nonSVT_coefficients(s, _InputSz);
-		}
+				return _S;
+			}
 
-		void dump_lastrow_diagnose(std::ostream& s) const
-		{
-			const size_t _Ordinal(_Forecasts.size()-1);
+			auto size() const ->size_t {return _Specs.size();}
 
-			for (size_t i=0; i<_Transforms[_Ordinal].size(); ++i) 
-				s << _Transforms[_Ordinal][i] << "\t" << _Forecasts[_Ordinal][i] << "\t\t";
+			auto ordinal(const size_t& k) const ->size_t {return _Ordinals[k];}
 
-			s << "\n";
-		}
+			auto select(const std::vector<size_t>& _Members) const ->selection_type {return _Members;}
 
-		void dump_lastrow_nonSVT_diagnose(std::ostream& s) const
-		{
-			const size_t _LastRow(_Forecasts.size()-1);
+			auto operator[](const size_t& k) ->spec_type& {return _Specs[k];}
 
-			for (size_t i=0; i<_Transforms[_LastRow].size(); ++i) 
-				if (!_Theorem.is_SVT_coefficient(i))
-					s << _Transforms[_LastRow][i] << "\t" << _Forecasts[_LastRow][i] << "\t\t";
+			auto operator[](const size_t& k) const ->const spec_type& {return _Specs[k];}
 
-			s << "\n";
-		}
+#ifdef DSPX_LATENCY
+			void set_latency(engine_latency& _L) {_Latency=&_L;} // histograms of the batch calls
+#endif
 
-	private:
+			void predict(const matrix_type& _M, const pointer& _Out, std::vector<char>& _Predicted, 
+				const selection_type& _Selection, work_stealing_pool& _Pool)
+			{// the members of _Selection not yet predicted, chunked by cache line of the forecast row (no false sharing)
 
-		template <class _Init>
-		void _optimize(const _Init& _Beg, const _Init& _End, vector_type& _Out)
-		{
-			const size_t SZ = source_size();
+				_Pending.clear(); _Lines.clear();
 
-			vector_type _CSrc(SZ), _CFcst1(SZ), _CFcst2(SZ);
+				for (auto I = _Selection.cbegin(), E = _Selection.cend(); I != E; ++I)
+				{
+					const size_t i(_Ordinals[*I]);
 
-			std::copy(_Beg, _End, _CSrc.begin());
+					if (_Predicted[i]) continue;
 
-			const value_type _Delta = 2.0;
+					if (_Lines.empty() || _cache_line(&_Out[i]) != _cache_line(&_Out[_Ordinals[_Pending.back()]])) 
+						
+						_Lines.push_back(_Pending.size());
 
-			_CSrc[_CSrc.size() - 1] = _CSrc[_CSrc.size() - 2] - _Delta;
-			
-			_DWT.transform(&_CSrc[0], &_CFcst1[0], SZ); // fwd transform 1
+					_Pending.push_back(*I);
+				}
 
-			_CSrc[_CSrc.size() - 1] = _CSrc[_CSrc.size() - 2] ; // repeat last known series value
+				_Lines.push_back(_Pending.size());
 
-			_DWT.transform(&_CSrc[0], &_CFcst2[0], SZ); // fwd transform 2
+				// each predictor has its own depot: one thread per chunk, ordinals disjoint
+				_Pool.parallel_for(_Lines.size() - 1, [this, &_M, &_Out](const size_t& k)
+				{
+					for (size_t z = _Lines[k]; z < _Lines[k + 1]; ++z)
+					{
+						const size_t m(_Pending[z]);
 
+						DSPX_LATENCY_SCOPE((*_Latency)[engine_latency::phase_predict]);
 
+						_Out[_Ordinals[m]] = _Specs[m].predict(_M, _Ordinals[m]);
+					}
+				});
 
-			std::map<size_t, value_type> alphas, betas, xs; // linear equation, Y=alpha*X +beta
+				for (auto I = _Pending.cbegin(), E = _Pending.cend(); I != E; ++I) _Predicted[_Ordinals[*I]] = 1;
+			}
 
+			auto update(const matrix_type& _M, const std::vector<char>& _Predicted, work_stealing_pool& _Pool) ->size_t
+			{
+				// retrain the members that forecasted, in parallel: they share matrix Q only, read only,
+				// and draw no random numbers, the results are those of a serial loop. Returns the training passes
 
-			for (size_t i = 0; i < SZ; ++i)
-			{// find slope and intersection
-				if (!_Theorem.is_SVT_coefficient(i))
+				_Pending.clear();
+
+				for (size_t k = 0; k < size(); ++k) if (_Predicted[_Ordinals[k]]) _Pending.push_back(k);
+
+				_Pool.parallel_for(_Pending.size(), [this, &_M](const size_t& z)
 				{
-					alphas[i] = (_CFcst2[i] - _CFcst1[i]) / _Delta;
-					betas[i] = _CFcst2[i];
-				}
-			}
+					const size_t m(_Pending[z]);
 
+					{
+						DSPX_LATENCY_SCOPE((*_Latency)[engine_latency::phase_train]);
 
-			for (size_t i = 0; i < SZ; ++i)
-			{// find Xs for each coefficient
-				if (!_Theorem.is_SVT_coefficient(i))
-				{ 
-					xs[i] /*create*/ = (_Out[i] - betas.at(i))/ alphas.at(i);
-				}
+						_Specs[m].update(_M, _Ordinals[m]);
+					}
+
+					DSPX_LATENCY_RECORD(_Latency->iterations(), _Specs[m].iterations());
+				});
+
+				size_t _Iterations(0);
+
+				for (auto I = _Pending.cbegin(), E = _Pending.cend(); I != E; ++I) _Iterations += _Specs[*I].iterations();
+
+				return _Iterations;
+			}
+
+			void update_async(const matrix_type& _M, const std::vector<char>& _Predicted, const size_t& _Tick, background_queue& _Q)
+			{// stage the trainings of the members that forecasted
+				for (size_t k = 0; k < size(); ++k) 
+					
+					if (_Predicted[_Ordinals[k]]) _Specs[k].update_async(_M, _Ordinals[k], _Tick, _Q);
 			}
 
-			// filter outlier xs values
-			real_vector_type VX;
+			void publish() { for (size_t k = 0; k < size(); ++k) _Specs[k].publish(); }
 
-			for (auto XI=xs.cbegin(), XE=xs.cend(); XI!=XE;++XI)
-				if (std::abs(XI->second)<2) VX.push_back(XI->second);
+			void save(std::ostream& s) const { for (size_t k = 0; k < size(); ++k) _Specs[k].save(s); }
 
-			// find aritmetic mean of filtered Xs
-			real_type X(ann::mean(VX));
-			
-			// optimize non-SVT coefficients...
-			for (size_t i = 0; i < SZ; ++i)
+			bool load(std::istream& s) 
+			{ 
+				for (size_t k = 0; k < size(); ++k) if (!_Specs[k].load(s)) return false; 
+				
+				return true;
+			}
+
+		private:
+
+			static auto _cache_line(const value_type* _P) ->std::uintptr_t
 			{
-				if (!_Theorem.is_SVT_coefficient(i))
-				{
-					_Out[i]= alphas[i]* X + betas[i];
-				}
+				return reinterpret_cast<std::uintptr_t>(_P) / 64;
 			}
-		}
 
 
-		void _reduce_predict()
-		{// forecast a new DWT crystal 
+			fixed_array<spec_type>		_Specs;		// members, in place
+			std::vector<size_t>			_Ordinals;	// coefficient of each member
+			std::vector<size_t>			_Pending;	// depot, members of a batch call
+			std::vector<size_t>			_Lines;		// depot, _Pending offsets of each cache line chunk
+#ifdef DSPX_LATENCY
+			engine_latency*				_Latency;	// see engine::latency()
+#endif
+		};
+
+		template <class matrix_type>
+		class predictor_group <matrix_type, shift_variance_theorem>
+		{// theorem coefficients transposition: copies of row segments of matrix Q, nothing to train
 
-			_Forecasts.push_back(vector_type(source_size()));
+			typedef typename matrix_type::pointer					pointer;
 
-			vector_type& _Out = *(--_Forecasts.end());
-			
-			// for each ordinal
-			for (size_t i = 0; i < source_size(); ++i)
+		public:
+
+			typedef std::vector<fwt::svt_segment>					selection_type;	// one copy each
+
+			predictor_group() : _Table() {}
+
+			void reserve(const size_t& _N) {_Table.reserve(_N);}
+
+			void emplace(const size_t& _Ordinal, const shift_variance_theorem& _Th)
 			{
-				// test predictor and store forecasted DWT coefficient
-				_Out[i] = _Predictors[i]->predict(_Transforms, i);
+				_Table.push_back(fwt::svt_segment{_Th.scale(_Ordinal), _Th.back_steps(_Ordinal), _Ordinal, 1});
 			}
-		}
 
-		template <class _Init>
-		void _full_transform(const _Init& _Beg, const _Init& _End)
-		{// save a new DWT crystal into matrix Q
+			auto size() const ->size_t {return _Table.size();}
 
-			_Transforms.push_back(vector_type(source_size()));
+			auto ordinal(const size_t& k) const ->size_t {return _Table[k]._First;}
 
-			vector_type& _Out = *(--_Transforms.end());
-			
-			_DWT.transform(_Beg._Ptr, &_Out[0], source_size());
-		}
+			auto select(const std::vector<size_t>& _Members) const ->selection_type
+			{// runs of consecutive ordinals of a scale merged, see shift_variance_theorem::svt_segments()
+				selection_type _S;
 
-		void _dump_nonSVT_coefficients(std::ostream& s, const size_t& _Srcsize) const
-		{
-			s << "variant coeff. ordinals: ";
+				for (auto I = _Members.cbegin(), E = _Members.cend(); I != E; ++I)
+				{
+					const fwt::svt_segment& _C(_Table[*I]);
 
-			for (size_t i = 0; i < _Srcsize; ++i)
-			{
-				if (!_Theorem.is_SVT_coefficient(i))
-					s << i << " ";
+					if (!_S.empty() && _S.back()._Scale == _C._Scale && _S.back()._First + _S.back()._Count == _C._First) 
+						
+						++_S.back()._Count;
+
+					else _S.push_back(_C);
+				}
+
+				return _S;
 			}
 
-			s << "\n";
-		}
+			void predict(const matrix_type& _M, const pointer& _Out, std::vector<char>& _Predicted, 
+				const selection_type& _Selection, work_stealing_pool& /*pool*/)
+			{
+				// one copy per segment: a coefficient already predicted is copied again, 
+				// the same value (matrix Q does not change until update())
 
+				const size_t _history_size(_M.size());
 
-		size_t								_InputSz;			// e.g. 128
-		transformer_type					_DWT;				// wavelet transform object
-		theorem_type						_Theorem;			// Theorem object
-		
-		matrix_type							_Transforms;		// transforms history (matrix Q)
-		matrix_type							_Forecasts;			// forecasted transforms history
+				for (auto I = _Selection.cbegin(), E = _Selection.cend(); I != E; ++I)
+				{
+					// precheck this...
+					if (_history_size < I->_Rows + 1) throw std::exception(M01);
 
-		matrix_type							_Sources;			// actual pattern history 
-		matrix_type							_Inverted;			// inverted transforms of forecasts, history 
+					// ritish columns transposed coefficients...
+					fwt::theorem_copy(_M, *I, _Out);
+
+					std::fill(_Predicted.begin() + I->_First, _Predicted.begin() + I->_First + I->_Count, char(1));
+				}
+			}
+
+			auto update(const matrix_type&, const std::vector<char>&, work_stealing_pool&) ->size_t {return 0;}
+
+			void update_async(const matrix_type&, const std::vector<char>&, const size_t&, background_queue&) {}
+
+			void publish() {}
+
+			void save(std::ostream&) const {}
+
+			bool load(std::istream&) {return true;}
+
+		private:
+
+			std::vector<fwt::svt_segment>		_Table;		// members, segments of one coefficient
+		};
+	}
+	
+	template <class matrix_type>
+	class predictor_container
+	{// predictors of the coefficients of a DWT, one contiguous group per kind, see predictor_group
+
+		typedef typename matrix_type::value_type						value_type;
+		typedef typename matrix_type::pointer							pointer;
+
+	public:
+
+		typedef predictor_group<matrix_type, shift_variance_theorem>		theorem_group_type;
+		typedef predictor_group<matrix_type, m1lp_t<value_type>>			neural_group_type;
+		
+		// ... import other predictor_group types here
+
+		enum predictor_kind {theorem_kind, neural_kind /*, other kinds*/};
+
+		struct selection_type
+		{// members of each group, see select()
+			typename theorem_group_type::selection_type		theorem;
+			typename neural_group_type::selection_type		neural;
+		};
+
+
+		predictor_container(const shift_variance_theorem& _Th)
+			: _Slots()
+			, _SVT()
+			, _MLP()
+		{
+			_default_create_predictors(_Th);
+		}
+
+		~predictor_container()
+		{}
+
+
+		auto kind(const size_t& i) const ->predictor_kind {return _Slots.at(i).first;}
+
+		auto select(const std::vector<size_t>& _Ordinals) const ->selection_type
+		{// the members predicting _Ordinals, group by group
+			std::vector<size_t> _Theorem, _Neural;
+
+			for (auto I = _Ordinals.cbegin(), E = _Ordinals.cend(); I != E; ++I)
+			{
+				const std::pair<predictor_kind, size_t>& _Slot(_Slots.at(*I));
+
+				switch (_Slot.first)
+				{
+				case theorem_kind: _Theorem.push_back(_Slot.second); break;
+				case neural_kind: _Neural.push_back(_Slot.second); break;
+				}
+			}
+
+			selection_type _S;
+
+			_S.theorem = _SVT.select(_Theorem); _S.neural = _MLP.select(_Neural);
+
+			return _S;
+		}
+
+#ifdef DSPX_LATENCY
+		void set_latency(engine_latency& _L) {_MLP.set_latency(_L);}
+#endif
+
+
+		// batch calls, one per group
+
+		void predict(const matrix_type& _M, const pointer& _Out, std::vector<char>& _Predicted, 
+			const selection_type& _S, work_stealing_pool& _Pool)
+		{// coefficients of _S not yet predicted, flagged in _Predicted
+			_SVT.predict(_M, _Out, _Predicted, _S.theorem, _Pool);
+
+			_MLP.predict(_M, _Out, _Predicted, _S.neural, _Pool);
+		}
+
+		auto update(const matrix_type& _M, const std::vector<char>& _Predicted, work_stealing_pool& _Pool) ->size_t
+		{// retrain the predictors of the coefficients in _Predicted, returns the training passes
+			return _SVT.update(_M, _Predicted, _Pool) + _MLP.update(_M, _Predicted, _Pool);
+		}
+
+		void update_async(const matrix_type& _M, const std::vector<char>& _Predicted, const size_t& _Tick, background_queue& _Q)
+		{
+			_SVT.update_async(_M, _Predicted, _Tick, _Q); _MLP.update_async(_M, _Predicted, _Tick, _Q);
+		}
+
+		void publish() {_SVT.publish(); _MLP.publish();}
+
+		void save(std::ostream& s) const {_SVT.save(s); _MLP.save(s);}
+
+		bool load(std::istream& s) {return _SVT.load(s) && _MLP.load(s);}
+
+
+		// single predictors, by coefficient ordinal
+
+		auto pending_error(const matrix_type& _M, const size_t& i) ->value_type 
+		{// error update() trains on, 0 if none
+			const std::pair<predictor_kind, size_t>& _Slot(_Slots.at(i));
+
+			return _Slot.first == neural_kind? _MLP[_Slot.second].pending_error(_M, i): 0;
+		}
+
+		auto update(const matrix_type& _M, const size_t& i, const ann::training_budget& _Budget) ->ann::training_status
+		{
+			const std::pair<predictor_kind, size_t>& _Slot(_Slots.at(i));
+
+			return _Slot.first == neural_kind? _MLP[_Slot.second].update(_M, i, _Budget): ann::training_converged;
+		}
+
+		auto iterations(const size_t& i) const ->size_t 
+		{// training passes of the last update()
+			const std::pair<predictor_kind, size_t>& _Slot(_Slots.at(i));
+
+			return _Slot.first == neural_kind? _MLP[_Slot.second].iterations(): 0;
+		}
+
+		auto staleness(const size_t& i, const size_t& _Tick) const ->size_t 
+		{// ticks behind the training samples
+			const std::pair<predictor_kind, size_t>& _Slot(_Slots.at(i));
+
+			return _Slot.first == neural_kind? _MLP[_Slot.second].staleness(_Tick): 0;
+		}
+
+		static auto neural_history() ->size_t {return neural_input_size() + 1;} // newest values of a column a default predictor reads
+
+		static auto create_neural_predictor(neural_group_type& _G, const size_t& _Ordinal) ->typename neural_group_type::spec_type&
+		{// default predictor of a non-SVT coefficient, see multi_engine
+
+			const size_t __NEURALINPUTSIZE = neural_input_size();
+
+			typename neural_group_type::spec_type& _P = 
+				_G.emplace(_Ordinal, __NEURALINPUTSIZE , 2*__NEURALINPUTSIZE , 1);
+				
+			//const value_type _MaxErr(.0001), _MinErr(.00001);
+			const value_type _MaxErr(.01), _MinErr(.000001);
+
+			_P.set_mlp_learningrate(0.1);
+
+			_P.set_mlp_mM_errors(_MaxErr, _MinErr);
+
+			return _P;
+		}
+
+	private:
+
+		static auto neural_input_size() ->size_t {return 8;}
+
+		predictor_container(const predictor_container&);	// not copyable
+
+		predictor_container& operator=(const predictor_container&);
+
+		void _default_create_predictors(const shift_variance_theorem& _Th)
+		{
+			size_t _Variant(0);
+
+			for (size_t i = 0; i < _Th.source_size(); ++i) if (!_Th.is_SVT_coefficient(i)) ++_Variant;
+
+			_SVT.reserve(_Th.source_size() - _Variant); _MLP.reserve(_Variant);
+
+			for (size_t i = 0; i < _Th.source_size(); ++i)
+			{
+				if (_Th.is_SVT_coefficient(i))
+				{
+					_Slots.push_back(std::make_pair(theorem_kind, _SVT.size()));
+
+					_SVT.emplace(i, _Th);
+				}
+				else // MLP, SOM/SOL, SVM, compound, etc. 
+				{// e.g. Daub4 -> 5 6 7 - 13 14 15 - 29 30 31 - 61 62 63 - 126 127
+					
+					_Slots.push_back(std::make_pair(neural_kind, _MLP.size()));
+
+					create_neural_predictor(_MLP, i);
+				}
+			}
+		}
+
+
+		std::vector<std::pair<predictor_kind, size_t>>	_Slots;		// kind and member of each coefficient
+		theorem_group_type								_SVT;		// theorem copies
+		neural_group_type								_MLP;		// neural networks
+	};
+
+	template <class FWT_type /*e.g. Daubechies<4>, Daubechies<4, float>*/>
+	class engine
+	{
+		typedef typename FWT_type::value_type				value_type;		// scalar type of the whole stack
+		typedef std::vector<value_type>						vector_type;
+		typedef fwt::timeline_matrix<value_type>			matrix_type;	// fixed capacity, contiguous, see set_column_major()
+		typedef typename matrix_type::pointer				pointer;
+		typedef typename matrix_type::const_pointer			const_pointer;
+
+		typedef FWT_type									transformer_type;
+		typedef fwt::shift_variance_theorem					theorem_type;
+		typedef predictor_container<matrix_type>			predictor_container_type;
+		typedef typename predictor_container_type::selection_type	selection_type;
+
+	public:
+
+		engine(const size_t& _DWTInputSz)
+			: _InputSz(_DWTInputSz)
+			, _DWT()
+			, _Plan(_DWT, _DWTInputSz) // allocation free transforms, on _DWT
+			, _Theorem(_DWTInputSz, _DWT.size()/2)
+			, _TheoremBacksteps()
+			, _VariantSizes()
+			, _Transforms(minQ_size()+1, source_size())	// one extra row, pushed before trimming
+			, _Forecasts(minQ_size()+1, source_size())	// ...
+			, _Sources()
+			, _Inverted(minQ_size()+1, source_size())		// ...
+			, _Predictors(_Theorem) // creates predictors
+			, _Fcst(source_size()) // allocate
+			, _Inv(source_size()) // ...
+			, _InvertedHistory(true)
+			, _Support()
+			, _Predicted(source_size(), 0)
+			, _Pending(false)
+			, _DemandForecast(false)
+			, _VariantIdx()
+			, _Ordinals()
+			, _Complete()
+			, _SupportSelection()
+			, _Response(source_size())
+			, _Betas(source_size())
+			, _Xs()
+			, _StagedWindow(source_size())
+			, _StagedRow(source_size())
+			, _Staged(false)
+			, _Pool(&work_stealing_pool::shared())
+			, _AsyncTraining(false)
+			, _Trainer(&background_queue::shared())
+			, _Tick(0)
+			, _BudgetIterations(0)
+			, _BudgetTime(0)
+			, _Priority()
+			, _TickIterations(0)
+			, _Exhausted(0)
+			, _Ring(2*source_size())
+			, _RingPos(0)
+			, _Buffered(0)
+		{
+			_retrieveVariantCoefficients();
+
+			_retrieveSVTBacksteps();
+
+			_retrieveSupport();
+
+			_retrieveResponse();
+
+#ifdef DSPX_LATENCY
+			_Predictors.set_latency(_Latency);
+#endif
+		}
+
+		~engine()
+		{}
+
+
+		bool trained() const {return _Forecasts.size()==_Transforms.size();} // predictors trained
+
+		bool inverted_history() const {return _InvertedHistory;}
+
+		void set_inverted_history(bool _B) 
+		{// if false, predict() reconstructs the forecasted sample only (point inverse)...
+			// ... and the history of inverted forecasts is no longer stored;
+			// only the coefficients supporting that sample are predicted, see complete_forecast()
+			_InvertedHistory=_B;
+
+			if (!_B) _Inverted.clear();
+		}
+
+		bool demand_forecast() const {return _DemandForecast;}
+
+		void set_demand_forecast(bool _B) 
+		{// if true, once Q is full an update() not preceded by predict() makes the forecast of the tick 
+			// itself (not inverted), so that the predictors train; if false it only appends to Q
+			_DemandForecast=_B;
+		}
+
+		void set_thread_pool(work_stealing_pool& _P) {_Pool=&_P;} // e.g. a pool of one worker: serial
+
+		auto transformer() ->transformer_type& {return _DWT;} // isa and scheme of all the transforms, see DWT_t::set_isa()
+
+		bool column_major() const {return _Transforms.tracked();}
+
+		void set_column_major(bool _B)
+		{// if true, matrix Q also keeps the history of each variant coefficient column major, 
+			// the newest values the MLPs read contiguous; forecasts unchanged
+			_Transforms.track(_B? _VariantIdx: std::vector<size_t>(), predictor_container_type::neural_history());
+		}
+
+		bool async_training() const {return _AsyncTraining;}
+
+		void set_async_training(bool _B)
+		{// if true, update() hands the retraining of the MLPs to background threads and returns;
+			// predict() uses the weights published last, see staleness()
+			wait_training();
+
+			_AsyncTraining=_B;
+		}
+
+		void set_background_queue(background_queue& _Q) { wait_training(); _Trainer=&_Q; }
+
+		void wait_training()
+		{// waits for the background retraining, and publishes its weights
+			if (!_AsyncTraining) return;
+
+			_Trainer->wait();
+
+			_Predictors.publish();
+		}
+
+		auto staleness(const size_t& i) const ->size_t 
+		{// ticks between the newest sample and the newest one the published weights of predictor i reflect
+			return _AsyncTraining? _Predictors.staleness(i, _Tick): 0;
+		}
+
+		auto max_staleness() const ->size_t
+		{
+			size_t _Max(0);
+
+			for (auto I = _VariantIdx.cbegin(), E = _VariantIdx.cend(); I != E; ++I) _Max = std::max(_Max, staleness(*I));
+
+			return _Max;
+		}
+
+		void set_training_budget(const size_t& _Iterations /*0: unbounded*/, 
+			const std::chrono::nanoseconds& _Time=std::chrono::nanoseconds(0) /*0: unbounded*/)
+		{
+			// per tick budget of the synchronous retraining in update(): the predictors 
+			// are retrained serially, largest error first, until the budget is exhausted; 
+			// those left keep their weights this tick
+
+			_BudgetIterations=_Iterations; _BudgetTime=_Time;
+		}
+
+		bool budgeted_training() const {return _BudgetIterations || _BudgetTime.count();}
+
+		auto training_iterations(const size_t& i) const ->size_t {return _Predictors.iterations(i);} // last update() of predictor i
+
+		auto tick_iterations() const ->size_t {return _TickIterations;} // training passes of the last synchronous update()
+
+		auto tick_exhausted() const ->size_t {return _Exhausted;} // predictors not retrained by the last budgeted update()
+
+#ifdef DSPX_LATENCY
+		auto latency() ->engine_latency& {return _Latency;} // per phase histograms, dump() or dump_json()
+
+		auto latency() const ->const engine_latency& {return _Latency;}
+#endif
+
+		auto source_size() const ->size_t {return _InputSz;}
+
+		auto history_size() const ->size_t {return _Transforms.size();}
+
+		auto minQ_size() const ->size_t {return _InputSz;}
+
+		auto minSVT_size() const ->size_t 
+		{// min no. of rows of Q required by the reduced transform (deepest backstep)
+			return _TheoremBacksteps.empty()? 0: *_TheoremBacksteps.crbegin();
+		}
+
+		auto predict()->value_type
+		{
+			// perform reduced FWT using the SVT theorem
+			// (the point inverse needs only the supporting coefficients)
+			_reduce_predict(_InvertedHistory);
+
+			// get a pointer to the crystal
+			pointer _Out = _Forecasts.back();
+
+			// inverse DWT, return the forecasted sample
+			return _invert(_Out);
+		}
+
+		template <class _Init>
+		auto predict(const _Init& _Beg, const _Init& _End)->value_type
+		{
+			// perform reduced FWT using the SVT theorem, complete crystal
+			_reduce_predict(true);
+
+			// get a pointer to the crystal
+			pointer _Out = _Forecasts.back();
+
+			// optimize crystal 
+			_optimize(_Beg, _End, _Out);
+
+			// inverse DWT, return the forecasted sample
+			return _invert(_Out);
+		}
+
+		template <class _Init>
+		auto update(const _Init& _Beg, const _Init& _End)
+		{
+			// push-pop a new value in the source queue, transform and store the new DWT.
+			// The predictors train on their forecast of this tick: call predict() first,
+			// without it nothing is retrained, unless set_demand_forecast()
+
+			if (_DemandForecast && !_Pending && history_size() >= minQ_size()) _demand_forecast();
+
+			// pattern discrete wavelet transform, unless predict() staged it already
+			if (_Staged && std::equal(_Beg, _End, _StagedWindow.cbegin())) _Transforms.push_back(&_StagedRow[0]); // commit
+
+			else _transform(_Beg, _End);
+
+			_Staged = false;
+			
+			// not enough history in Q...
+			if (history_size() <= minQ_size()) { _Pending = false; return; }
+
+			// trim excess row in Q front...
+			_Transforms.pop_front();
+
+
+			// retrain the predictors that forecasted this tick only (point inverse mode)
+			++_Tick;
+
+			// asynchronous: stage the trainings only, the background threads do not read Q
+			if (_AsyncTraining) _Predictors.update_async(_Transforms, _Predicted, _Tick, *_Trainer);
+
+			else if (budgeted_training()) _budgeted_update();
+
+			else 
+			{
+				// each group in parallel, see predictor_group::update()
+				_TickIterations = _Predictors.update(_Transforms, _Predicted, *_Pool); 
+				
+				_Exhausted = 0;
+			}
+
+			// the forecast is no longer pending
+			std::fill(_Predicted.begin(), _Predicted.end(), 0);
+
+			_Pending = false;
+		}
+
+		template <class _Range>
+		auto predict(const _Range& _R)->value_type
+		{// any contiguous range of source size samples, e.g. std::vector, std::array
+			return predict(std::begin(_R), std::end(_R));
+		}
+
+		template <class _Range>
+		void update(const _Range& _R) 
+		{// ...
+			update(std::begin(_R), std::end(_R));
+		}
+
+
+		// streaming: one sample per bar, the engine keeps the window. The newest source size 
+		// samples are stored twice, at k and k+source size, so that the window is always
+		// contiguous in the ring and reaches the transforms without copies. 
+		// Use either push() or update(), not both
+
+		void push(const value_type& _X)
+		{// update() with the window ending in _X, once source size samples are buffered
+
+			_Ring[_RingPos] = _X; _Ring[_RingPos + source_size()] = _X;
+
+			if (++_RingPos == source_size()) _RingPos = 0;
+
+			if (_Buffered < source_size()) ++_Buffered;
+
+			if (_Buffered == source_size()) update(window(), window() + source_size());
+		}
+
+		template <class _Init>
+		void push(_Init _Beg, const _Init& _End) { for (; _Beg != _End; ++_Beg) push(*_Beg); }
+
+		auto forecast()->value_type
+		{// predict() the sample the next push() completes, see trained()
+			return predict();
+		}
+
+		auto buffered() const ->size_t {return _Buffered;} // samples of the window pushed so far
+
+		auto window() const ->const_pointer {return &_Ring[_RingPos];} // oldest to newest, once buffered() is source size
+
+		template <class _Init>
+		void update_batch(const _Init& _Beg, const _Init& _End)
+		{
+			// update() for each window starting in [_Beg, _End), one sample apart (see _Create()):
+			// while matrix Q is filled no predictor is retrained, the transforms of those windows
+			// are batched on the thread pool (see DWT::transform_batch()), the others go through update()
+
+			_Staged = false;
+
+			const size_t _Count(std::distance(_Beg, _End));
+
+			const size_t _Batch((history_size() < minQ_size())? std::min(_Count, minQ_size() - history_size()): 0);
+
+			if (_Batch)
+			{
+				if (_BatchRows.size() < _Batch*source_size()) _BatchRows.resize(_Batch*source_size());
+
+				_Plan.execute_batch(&*_Beg, &_BatchRows[0], _Batch, 1, *_Pool);
+
+				for (size_t k=0; k<_Batch; ++k) _Transforms.push_back(&_BatchRows[k*source_size()]);
+
+				_Pending = false;
+			}
+
+			for (auto I = _Beg + _Batch; I != _End; ++I) update(I, I + source_size());
+		}
+
+		void complete_forecast()
+		{// lazily predict the coefficients skipped by the point inverse mode...
+			// ... so that the newest forecasted crystal is complete; call before update()
+
+			if (!_Pending) throw std::exception(M03);
+
+			_complete_forecast(_Forecasts.back());
+		}
+
+
+		// snapshots: matrix Q, forecasts and inverted histories, predictors state; 
+		// a loaded engine continues as the saved one. Thread pools, budgets 
+		// and the asynchronous mode are settings of the process, not saved
+
+		void save_snapshot(const path_type& P)
+		{
+			std::ofstream fout(P.string(), std::ios::binary);
+
+			save_snapshot(fout);
+		}
+
+		void save_snapshot(std::ostream& s)
+		{
+			wait_training(); // published weights
+
+			s.write("DSPXSNAP", _SnapshotMagicSz);
+
+			binary_put(s, std::uint32_t(_SnapshotVersion)); 
+			
+			binary_put(s, std::uint32_t(sizeof(value_type)));
+
+			binary_put(s, std::uint64_t(_DWT.size())); binary_put(s, std::uint64_t(_InputSz));
+
+			binary_put(s, char(_InvertedHistory)); binary_put(s, char(_Pending)); binary_put(s, char(_Staged));
+
+			binary_put(s, std::uint64_t(_Tick));
+
+			s.write(&_Predicted[0], _Predicted.size());
+
+			s.write(reinterpret_cast<const char*>(&_StagedWindow[0]), _StagedWindow.size()*sizeof(value_type));
+
+			s.write(reinterpret_cast<const char*>(&_StagedRow[0]), _StagedRow.size()*sizeof(value_type));
+
+			_Transforms.write(s); _Forecasts.write(s); _Inverted.write(s);
+
+			binary_put(s, std::uint64_t(_Buffered)); // the window of push(), oldest first
+
+			s.write(reinterpret_cast<const char*>(window()), source_size()*sizeof(value_type));
+
+			_Predictors.save(s); // in the order of the coefficients, group by group
+
+			if (!s.good()) throw std::exception(M06);
+		}
+
+		void load_snapshot(const path_type& P)
+		{// the file is mapped, and read in place
+			boost::iostreams::mapped_file_source _Map(P.string());
+
+			memory_streambuf _Buf(_Map.data(), _Map.size());
+
+			std::istream _S(&_Buf);
+
+			load_snapshot(_S);
+		}
+
+		void load_snapshot(std::istream& s)
+		{
+			wait_training(); // no training in flight
+
+			char _Magic[_SnapshotMagicSz] = {0};
+
+			std::uint32_t _Version(0), _Scalar(0);
+
+			s.read(_Magic, sizeof(_Magic)); binary_get(s, _Version); binary_get(s, _Scalar);
+
+			if (!s.good() || !std::equal(_Magic, _Magic + _SnapshotMagicSz, "DSPXSNAP") || _Version != _SnapshotVersion) 
+				
+				throw std::exception(M04);
+
+			std::uint64_t _Wavelet(0), _Source(0), _Ticks(0);
+
+			binary_get(s, _Wavelet); binary_get(s, _Source);
+
+			if (_Scalar != sizeof(value_type) || _Wavelet != _DWT.size() || _Source != _InputSz) throw std::exception(M05);
+
+			char _Inv(0), _Pnd(0), _Stg(0);
+
+			binary_get(s, _Inv); binary_get(s, _Pnd); binary_get(s, _Stg);
+
+			binary_get(s, _Ticks);
+
+			s.read(&_Predicted[0], _Predicted.size());
+
+			s.read(reinterpret_cast<char*>(&_StagedWindow[0]), _StagedWindow.size()*sizeof(value_type));
+
+			s.read(reinterpret_cast<char*>(&_StagedRow[0]), _StagedRow.size()*sizeof(value_type));
+
+			if (!_Transforms.read(s) || !_Forecasts.read(s) || !_Inverted.read(s)) throw std::exception(M06);
+
+			std::uint64_t _Buf(0);
+
+			binary_get(s, _Buf);
+
+			s.read(reinterpret_cast<char*>(&_Ring[0]), source_size()*sizeof(value_type));
+
+			std::copy(&_Ring[0], &_Ring[0] + source_size(), &_Ring[0] + source_size());
+
+			_RingPos = 0; _Buffered = size_t(_Buf);
+
+			if (!_Predictors.load(s)) throw std::exception(M06);
+
+			_InvertedHistory = _Inv != 0; _Pending = _Pnd != 0; _Staged = _Stg != 0; _Tick = size_t(_Ticks);
+		}
+
+
+		// diagnostic outputs
+
+		void dump_engine_diagnose(std::ostream& s) const
+		{
+			_dump_nonSVT_coefficients(s, _InputSz);
+		}
+
+		void dump_lastrow_diagnose(std::ostream& s) const
+		{
+			const size_t _Ordinal(_Forecasts.size()-1);
+
+			for (size_t i=0; i<_Transforms.columns(); ++i) 
+				s << _Transforms[_Ordinal][i] << "\t" << _Forecasts[_Ordinal][i] << "\t\t";
+
+			s << "\n";
+		}
+
+		void dump_lastrow_nonSVT_diagnose(std::ostream& s) const
+		{
+			const size_t _LastRow(_Forecasts.size()-1);
+
+			for (size_t i=0; i<_Transforms.columns(); ++i) 
+				if (!_Theorem.is_SVT_coefficient(i))
+					s << _Transforms[_LastRow][i] << "\t" << _Forecasts[_LastRow][i] << "\t\t";
+
+			s << "\n";
+		}
+
+	private:
+
+		auto _invert(const pointer& _Out)->value_type
+		{// inverse DWT of the forecasted crystal, returns the forecasted sample
+
+			DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_inverse]);
+
+			// trim excess forecast row from the storage (the row is not reused before the next push)
+			if (_Forecasts.size() > minQ_size()) _Forecasts.pop_front();
+
+			// point inverse, only the last sample of the inverted DWT
+			if (!_InvertedHistory) return _Plan.execute_point(_Out, source_size()-1);
+
+			// perform inverse DWT on it
+			_Plan.execute_inverse(_Out, &_Inv[0]);
+			
+			// store inverse DWT (forecasted series)
+			_Inverted.push_back(&_Inv[0]);
+
+			// trim...
+			if (_Inverted.size() > minQ_size()) _Inverted.pop_front();
+			
+			// return last element of the inverted DWT
+			return *_Inv.crbegin();
+		}
+
+		template <class _Init>
+		void _optimize(const _Init& _Beg, const _Init& _End, const pointer& _Out)
+		{
+			// the DWT is linear, each coefficient is a linear function of the last sample X:
+			// Y=alpha*X +beta, where alpha is the response to a unit impulse in the last sample 
+			// (cached) and beta the transform of the window with the last value repeated.
+			// beta is taken from the transform of the window itself, staged for update()
+
+			const size_t SZ = source_size();
+
+			_stage_transform(_Beg, _End);
+
+			DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_optimize]); // the staged transform excluded
+
+			const_pointer _Known = &_StagedRow[0]; // transform of [_Beg, _End)
+
+			const value_type _Dx = *(_End - 2) - *(_End - 1); // last sample, repeated minus actual
+
+			_Xs.clear(); // flat depot, no allocation
+
+
+			for (auto I = _VariantIdx.cbegin(), E = _VariantIdx.cend(); I != E; ++I)
+			{// find intersection and X for each non-SVT coefficient
+				const size_t i(*I);
+
+				_Betas[i] = _Known[i] + _Response[i] * _Dx;
+
+				if (_Response[i] == 0) continue; // coefficient independent of the last sample
+
+				const value_type x((_Out[i] - _Betas[i]) / _Response[i]);
+
+				// filter outlier xs values
+				if (std::abs(x) < 2) _Xs.push_back(x);
+			}
+
+			// find aritmetic mean of filtered Xs
+			value_type X(ann::mean(_Xs));
+			
+			// optimize non-SVT coefficients...
+			for (auto I = _VariantIdx.cbegin(), E = _VariantIdx.cend(); I != E; ++I)
+			{
+				_Out[*I] = _Response[*I] * X + _Betas[*I];
+			}
+		}
+
+		template <class _Init>
+		void _stage_transform(const _Init& _Beg, const _Init& _End)
+		{
+			// the transform of the window into _StagedRow, ahead of update(), which commits it 
+			// to Q if the window is the same: Q is not touched between predict() and update()
+
+			if (_TheoremBacksteps.empty() || history_size() < minSVT_size()) 
+			{// warm-up, see _transform()
+				DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_forward]);
+
+				_Plan.execute_forward(&*_Beg, &_StagedRow[0]);
+			}
+			else
+			{
+				DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_reduced]);
+
+				std::fill(_StagedRow.begin(), _StagedRow.end(), value_type(0)); // the reduced transform accumulates
+
+				_Plan.execute_ahead(_Transforms, &*_Beg, &_StagedRow[0]);
+			}
+
+			std::copy(_Beg, _End, _StagedWindow.begin());
+
+			_Staged = true;
+		}
+
+		void _reduce_predict(bool _Full)
+		{// forecast a new DWT crystal 
+
+			pointer _Out = _Forecasts.push_back(); // zeroed row
+
+			std::fill(_Predicted.begin(), _Predicted.end(), 0);
+
+			_Pending = true;
+
+			// weights trained in background since the last tick
+			if (_AsyncTraining) _Predictors.publish();
+
+			if (_Full) { _complete_forecast(_Out); return; }
+
+			// only the coefficients the forecasted sample depends on
+			_predict_coefficients(_Out, _SupportSelection);
+		}
+
+		void _demand_forecast()
+		{// the forecast of predict(), for update() only
+			_reduce_predict(_InvertedHistory);
+
+			if (_Forecasts.size() > minQ_size()) _Forecasts.pop_front();
+		}
+
+		void _complete_forecast(const pointer& _Out)
+		{// each ordinal not yet predicted
+			_predict_coefficients(_Out, _Complete);
+		}
+
+		void _predict_coefficients(const pointer& _Out, const selection_type& _Selection)
+		{// store forecasted DWT coefficients: SVT copies in one pass, then the neural predictors in parallel
+			_Predictors.predict(_Transforms, _Out, _Predicted, _Selection, *_Pool);
+		}
+
+		static const size_t					_SnapshotMagicSz = 8;	// "DSPXSNAP", no terminator
+
+		static const std::uint32_t			_SnapshotVersion = 1;	// format of save_snapshot()
+
+		void _budgeted_update()
+		{// retrain the predictors that forecasted within the tick budget, largest error first
+
+			typedef ann::training_budget::clock_type	clock_type;
+
+			const clock_type::time_point _Deadline(_BudgetTime.count()? 
+				clock_type::now() + std::chrono::duration_cast<clock_type::duration>(_BudgetTime): clock_type::time_point::max());
+
+			_Priority.clear();
+
+			for (auto I = _VariantIdx.cbegin(), E = _VariantIdx.cend(); I != E; ++I)
+			{
+				if (!_Predicted[*I]) continue;
+
+				const value_type _Err(_Predictors.pending_error(_Transforms, *I));
+
+				if (_Err > 0) _Priority.push_back(std::make_pair(_Err, *I));
+			}
+
+			// largest error first, ties by ordinal
+			std::sort(_Priority.begin(), _Priority.end(), [](const std::pair<value_type, size_t>& a, const std::pair<value_type, size_t>& b) 
+			{
+				return a.first > b.first || (a.first == b.first && a.second < b.second);
+			});
+
+			_TickIterations = 0; _Exhausted = 0;
+
+			for (auto I = _Priority.cbegin(), E = _Priority.cend(); I != E; ++I)
+			{
+				if (_BudgetIterations && _TickIterations >= _BudgetIterations) { ++_Exhausted; continue; }
+
+				const ann::training_budget _Budget(_BudgetIterations? _BudgetIterations - _TickIterations: 0, _Deadline);
+
+				if (_Budget.exhausted(0)) { ++_Exhausted; continue; } // deadline
+
+				{
+					DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_train]);
+
+					if (_Predictors.update(_Transforms, I->second, _Budget) == ann::training_budget_exhausted) ++_Exhausted;
+				}
+
+				DSPX_LATENCY_RECORD(_Latency.iterations(), _Predictors.iterations(I->second));
+
+				_TickIterations += _Predictors.iterations(I->second);
+			}
+		}
+
+		template <class _Init>
+		void _transform(const _Init& _Beg, const _Init& _End)
+		{// save a new DWT crystal into matrix Q
+			
+			// the reduced transform assumes that each update() shifts 
+			// the source window by exactly one sample (streaming)
+
+			if (_TheoremBacksteps.empty() || history_size() < minSVT_size()) 
+				
+				_full_transform(_Beg, _End); // warm-up
+
+			else _theorem_transform(_Beg, _End);
+		}
+
+		template <class _Init>
+		void _full_transform(const _Init& _Beg, const _Init& _End)
+		{// save a new DWT crystal into matrix Q
+
+			DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_forward]);
+
+			pointer _Out = _Transforms.push_back();
+			
+			_Plan.execute_forward(&*_Beg, _Out);
+
+			_Transforms.commit_back();
+		}
+
+		template <class _Init>
+		void _theorem_transform(const _Init& _Beg, const _Init& _End)
+		{// save a new DWT crystal into matrix Q, calculated using the shift variance theorem
+
+			DSPX_LATENCY_SCOPE(_Latency[engine_latency::phase_reduced]);
+
+			pointer _Out = _Transforms.push_back(); // zeroed, the reduced transform accumulates
+
+			_Plan.execute_reduced(_Transforms, &*_Beg, _Out);
+
+			_Transforms.commit_back();
+		}
+
+		void _retrieveVariantCoefficients()
+		{// number of variant coefficients for each scale
+			_Theorem.variant_coefficients(_VariantSizes);
+		}
+
+		void _retrieveResponse()
+		{
+			// non-SVT coefficients ordinals, all of them by kind...
+			for (size_t i = 0; i < source_size(); ++i) 
+			{
+				if (!_Theorem.is_SVT_coefficient(i)) _VariantIdx.push_back(i);
+
+				_Ordinals.push_back(i);
+			}
+
+			_Complete = _Predictors.select(_Ordinals);
+
+			_Xs.reserve(_VariantIdx.size());
+
+			// ... and the DWT column of the last sample: response to a unit impulse
+			vector_type _Impulse(source_size(), 0);
+
+			*_Impulse.rbegin() = 1;
+
+			_DWT.transform(&_Impulse[0], &_Response[0], source_size());
+		}
+
+		void _retrieveSupport()
+		{// coefficients the newest sample of the inverse DWT depends on (point inverse)
+			_DWT.support(source_size(), source_size()-1, source_size(), _Support);
+
+			_SupportSelection = _Predictors.select(_Support);
+		}
+
+		void _retrieveSVTBacksteps()
+		{
+			// retrieve backsteps necessary to copy...
+			// ...SVT coefficients from matrix Q
+
+			for (size_t _N=_InputSz/2; 
+					_N>=std::pow(2.0, std::ceil(std::log2(_DWT.size()))); 
+						_N>>=1)
+
+				_TheoremBacksteps.push_back(_Theorem.back_steps(_N));
+		}
+
+		void _dump_nonSVT_coefficients(std::ostream& s, const size_t& _Srcsize) const
+		{
+			s << "variant coeff. ordinals: ";
+
+			for (size_t i = 0; i < _Srcsize; ++i)
+			{
+				if (!_Theorem.is_SVT_coefficient(i))
+					s << i << " ";
+			}
+
+			s << "\n";
+		}
+
+
+		size_t								_InputSz;			// e.g. 128
+		transformer_type					_DWT;				// wavelet transform object
+		fwt::dwt_plan_t<value_type>			_Plan;				// transform plan of _DWT, scratch memory
+		vector_type							_BatchRows;			// transforms of update_batch(), grown, never shrunk
+		theorem_type						_Theorem;			// Theorem object
+		std::vector<size_t>					_TheoremBacksteps;	// backsteps for theorem copy
+		std::vector<size_t>					_VariantSizes;		// number of variant coefficients for each scale
+		
+		matrix_type							_Transforms;		// transforms history (matrix Q)
+		matrix_type							_Forecasts;			// forecasted transforms history
+
+		std::vector<vector_type>			_Sources;			// actual pattern history 
+		matrix_type							_Inverted;			// inverted transforms of forecasts, history 
 
 		predictor_container_type			_Predictors;		// predictor container wrapper and factory
 		vector_type							_Fcst;				// depot vector
 		vector_type							_Inv;				// depot vector
+		bool								_InvertedHistory;	// full inverse DWT and _Inverted history, or point inverse
+		std::vector<size_t>					_Support;			// coefficients the newest forecasted sample depends on
+		std::vector<char>					_Predicted;			// coefficients predicted for the pending forecast
+		bool								_Pending;			// a forecast awaits the next update()
+		bool								_DemandForecast;	// update() forecasts, if predict() did not
+
+		std::vector<size_t>					_VariantIdx;		// non-SVT coefficients ordinals
+		std::vector<size_t>					_Ordinals;			// all the coefficients ordinals
+		selection_type						_Complete;			// predictors of _Ordinals, by kind
+		selection_type						_SupportSelection;	// predictors of _Support, ...
+		vector_type							_Response;			// DWT of a unit impulse in the last sample
+		vector_type							_Betas;				// depot vector, _optimize()
+		vector_type							_Xs;				// ...
+		vector_type							_StagedWindow;		// window of the transform staged by predict()
+		vector_type							_StagedRow;			// its transform, committed to Q by update()
+		bool								_Staged;			// _StagedRow awaits update()
+		work_stealing_pool*					_Pool;				// prediction and retraining threads
+		bool								_AsyncTraining;		// retraining on background threads
+		background_queue*					_Trainer;			// ...
+		size_t								_Tick;				// no. of updates that trained the predictors
+		size_t								_BudgetIterations;	// training passes per tick, 0: unbounded
+		std::chrono::nanoseconds			_BudgetTime;		// training time per tick, 0: unbounded
+		std::vector<std::pair<value_type, size_t>>	_Priority;	// depot, pending errors and ordinals
+		size_t								_TickIterations;	// training passes of the last synchronous update()
+		size_t								_Exhausted;			// predictors left by the last budgeted update()
+		vector_type							_Ring;				// newest source size samples, mirrored, see push()
+		size_t								_RingPos;			// oldest sample of the window, next one overwritten
+		size_t								_Buffered;			// samples in the ring, up to source size
+#ifdef DSPX_LATENCY
+		engine_latency						_Latency;			// per phase latency histograms
+#endif
+
+	};
+
+
+	template <class FWT_type /*e.g. Daubechies<4>*/>
+	class multi_engine
+	{
+		// the engine of K symbols sharing one configuration, ticked together.
+		// Matrix Q holds the transforms of all the symbols interleaved, the coefficient i 
+		// of the symbol s at column i*K+s: the transforms, the theorem copies and the inverses 
+		// run once per tick, the lanes of the vectors spanning the symbols. 
+		// Each symbol keeps its own MLPs, reading their inputs from its columns of Q.
+		// The forecasts of each symbol are bit identical to those of an engine (full inverse,
+		// convolution scheme) built in the order of the symbols: the MLPs draw the same weights
+
+		typedef typename FWT_type::value_type				value_type;
+		typedef std::vector<value_type>						vector_type;
+		typedef fwt::timeline_matrix<value_type>			matrix_type;	// rows of K*source size coefficients
+		typedef typename matrix_type::pointer				pointer;
+		typedef typename matrix_type::const_pointer			const_pointer;
+
+		typedef FWT_type									transformer_type;
+		typedef fwt::shift_variance_theorem					theorem_type;
+		typedef predictor_container<matrix_type>			predictor_container_type;
+		typedef typename predictor_container_type::neural_group_type	neural_group_type;
+
+	public:
+
+		multi_engine(const size_t& _DWTInputSz, const size_t& _Symbols)
+			: _InputSz(_DWTInputSz)
+			, _K(_Symbols)
+			, _DWT()
+			, _Plan(_DWT, _DWTInputSz) // ...
+			, _Theorem(_DWTInputSz, _DWT.size()/2)
+			, _TheoremBacksteps()
+			, _Transforms(minQ_size()+1, source_size()*_Symbols)	// one extra row, pushed before trimming
+			, _Forecasts(minQ_size()+1, source_size()*_Symbols)	// ...
+			, _Window(source_size()*_Symbols)
+			, _Inv(source_size()*_Symbols)
+			, _Work(_Plan.workspace_size()*_Symbols)
+			, _VariantIdx()
+			, _Segments()
+			, _Neural()
+			, _Pending(false)
+			, _DemandForecast(false)
+			, _Pool(&work_stealing_pool::shared())
+		{
+			if (!_K) throw std::exception("multi engine failure, no symbols");
+
+			_retrieveSVTBacksteps();
+
+			_retrieveCoefficients();
+
+			_create_predictors();
+		}
+
+		~multi_engine()
+		{}
+
+
+		bool trained() const {return _Forecasts.size()==_Transforms.size();} // predictors trained
+
+		auto symbols() const ->size_t {return _K;}
+
+		bool demand_forecast() const {return _DemandForecast;}
+
+		void set_demand_forecast(bool _B) {_DemandForecast=_B;} // see engine::set_demand_forecast()
+
+		void set_thread_pool(work_stealing_pool& _P) {_Pool=&_P;} // e.g. a pool of one worker: serial
+
+		auto transformer() ->transformer_type& {return _DWT;} // isa and scheme of all the transforms, see DWT_t::set_isa()
+
+		bool column_major() const {return _Transforms.tracked();}
+
+		void set_column_major(bool _B)
+		{// if true, matrix Q also keeps the columns of the variant coefficients of all the symbols 
+			// column major, see engine::set_column_major()
+			std::vector<size_t> _Columns;
+
+			if (_B) for (auto I = _VariantIdx.cbegin(), E = _VariantIdx.cend(); I != E; ++I)
+				
+				for (size_t s = 0; s < _K; ++s) _Columns.push_back(*I*_K + s);
+
+			_Transforms.track(_Columns, predictor_container_type::neural_history());
+		}
+
+		auto source_size() const ->size_t {return _InputSz;}
+
+		auto history_size() const ->size_t {return _Transforms.size();}
+
+		auto minQ_size() const ->size_t {return _InputSz;}
+
+		auto minSVT_size() const ->size_t 
+		{// min no. of rows of Q required by the reduced transform (deepest backstep)
+			return _TheoremBacksteps.empty()? 0: *_TheoremBacksteps.crbegin();
+		}
+
+		void predict(const pointer& _Fcst /*one forecasted sample per symbol*/)
+		{
+			// forecast a new DWT crystal of each symbol...
+			pointer _Out = _Forecasts.push_back(); // zeroed row
+
+			_Pending = true;
+
+			const size_t _history_size(history_size());
+
+			// ... theorem coefficients, one copy per scale of the K symbols
+			for (auto I = _Segments.cbegin(), E = _Segments.cend(); I != E; ++I)
+			{
+				if (_history_size < I->_Rows + 1) throw std::exception(M01);
+
+				fwt::theorem_copy(_Transforms, *I, _Out, _K);
+			}
+
+			// ... MLPs in parallel, each task the K contiguous columns of one coefficient
+			_Pool->parallel_for(_VariantIdx.size(), [this, &_Out](const size_t& v)
+			{
+				for (size_t s = 0; s < _K; ++s)
+				{
+					const size_t c(_VariantIdx[v]*_K + s);
+
+					_Out[c] = _Neural[s*_VariantIdx.size() + v].predict(_Transforms, c);
+				}
+			});
+
+			// trim excess forecast row from the storage (the row is not reused before the next push)
+			if (_Forecasts.size() > minQ_size()) _Forecasts.pop_front();
+
+			// inverse DWT of all the symbols, the last sample of each is the forecast
+			_Plan.execute_inverse(_Out, &_Inv[0], _K, &_Work[0]);
+
+			std::copy(&_Inv[(source_size()-1)*_K], &_Inv[0] + source_size()*_K, _Fcst);
+		}
+
+		void update(const const_pointer* _Windows /*newest window of each symbol, source size samples*/)
+		{
+			// push-pop a new value in the source queues, transform and store the new DWTs.
+			// The MLPs train on their forecast of this tick, see engine::update()
+
+			if (_DemandForecast && !_Pending && history_size() >= minQ_size()) _demand_forecast();
+
+			// interleave the windows
+			for (size_t s = 0; s < _K; ++s)
+			{
+				const_pointer _Src(_Windows[s]);
+
+				for (size_t k = 0; k < source_size(); ++k) _Window[k*_K + s] = _Src[k];
+			}
+
+			// pattern discrete wavelet transform of all the symbols
+			pointer _Out = _Transforms.push_back(); // zeroed, the reduced transform accumulates
+
+			if (_TheoremBacksteps.empty() || history_size() <= minSVT_size()) 
+
+				_Plan.execute_forward(&_Window[0], _Out, _K, &_Work[0]); // warm-up
+
+			else _Plan.execute_reduced(_Transforms, &_Window[0], _Out, _K, &_Work[0]);
+
+			_Transforms.commit_back();
+
+			// not enough history in Q...
+			if (history_size() <= minQ_size()) { _Pending = false; return; }
+
+			// trim excess row in Q front...
+			_Transforms.pop_front();
+
+			// retrain the MLPs that forecasted this tick, in parallel (see engine::update())
+			if (_Pending) _Pool->parallel_for(_Neural.size(), [this](const size_t& k)
+			{
+				_Neural[k].update(_Transforms, _Neural.ordinal(k));
+			});
+
+			_Pending = false;
+		}
+
+	private:
+
+		void _demand_forecast()
+		{// the MLP forecasts of predict(), for update() only
+			_Pending = true;
+
+			_Pool->parallel_for(_Neural.size(), [this](const size_t& k)
+			{
+				_Neural[k].predict(_Transforms, _Neural.ordinal(k));
+			});
+		}
+
+		multi_engine(const multi_engine&);	// not copyable
+
+		multi_engine& operator=(const multi_engine&);
+
+		void _retrieveSVTBacksteps()
+		{// see engine
+
+			for (size_t _N=_InputSz/2; 
+					_N>=std::pow(2.0, std::ceil(std::log2(_DWT.size()))); 
+						_N>>=1)
+
+				_TheoremBacksteps.push_back(_Theorem.back_steps(_N));
+		}
+
+		void _retrieveCoefficients()
+		{// non-SVT coefficients ordinals, SVT coefficients segments
+
+			for (size_t i = 0; i < source_size(); ++i) if (!_Theorem.is_SVT_coefficient(i)) _VariantIdx.push_back(i);
+
+			_Theorem.svt_segments(_Segments);
+		}
+
+		void _create_predictors()
+		{// symbol by symbol, in the order of the coefficients: the order of the random draws of K engines
+
+			_Neural.reserve(_K*_VariantIdx.size());
+
+			for (size_t s = 0; s < _K; ++s)
+
+				for (size_t v = 0; v < _VariantIdx.size(); ++v)
+
+					predictor_container_type::create_neural_predictor(_Neural, _VariantIdx[v]*_K + s);
+		}
+
+
+		size_t									_InputSz;			// e.g. 128
+		size_t									_K;					// no. of symbols
+		transformer_type						_DWT;				// wavelet transform object
+		fwt::dwt_plan_t<value_type>				_Plan;				// transform plan of _DWT, theorem tables
+		theorem_type							_Theorem;			// Theorem object
+		std::vector<size_t>						_TheoremBacksteps;	// backsteps for theorem copy
+
+		matrix_type								_Transforms;		// transforms history (matrix Q), interleaved
+		matrix_type								_Forecasts;			// forecasted transforms history, ...
+
+		vector_type								_Window;			// depot, interleaved windows
+		vector_type								_Inv;				// depot, interleaved inverse DWTs
+		vector_type								_Work;				// workspace of the interleaved transforms
 
+		std::vector<size_t>						_VariantIdx;		// non-SVT coefficients ordinals
+		std::vector<fwt::svt_segment>			_Segments;			// SVT coefficients, one segment per scale
+		neural_group_type						_Neural;			// MLPs, symbol major, of the columns of Q
+		bool									_Pending;			// a forecast awaits the next update()
+		bool									_DemandForecast;	// update() forecasts, if predict() did not
+		work_stealing_pool*						_Pool;				// prediction and retraining threads
 	};
-}
\ No newline at end of file
+}
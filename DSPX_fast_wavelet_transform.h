@@ -15,14 +15,37 @@
 
 namespace fast_wavelet_transform
 {
+	struct svt_segment
+	{
+		// contiguous theorem coefficients of one scale, transposed from the same row of matrix Q:
+		// [_First, _First+_Count) <- row Q.size()-_Rows, columns [_First+1, _First+_Count+1)
+
+		size_t		_Scale;		// scale j
+		size_t		_Rows;		// source row offset, from the end of Q
+		size_t		_First;		// destination ordinal
+		size_t		_Count;		// no. of coefficients
+	};
+
+	template <class _Matrix, class T>
+	inline void theorem_copy(const _Matrix& _Q /*vector of rows or circular_matrix*/, 
+		const svt_segment& _S, T* _Dest, const size_t& _Lanes=1 /*interleaved series*/)
+	{// one segment copy; Q must hold more than _S._Rows rows
+		const T* _Src(&_Q[_Q.size() - _S._Rows][(_S._First + 1)*_Lanes]);
+
+		std::copy(_Src, _Src + _S._Count*_Lanes, _Dest + _S._First*_Lanes);
+	}
+
 	struct shift_variance_theorem
 	{
 		size_t						_Srcsize;	// time series size
 		size_t						_N;			// wavelet support
 		size_t						_maxjexp;	// max scaling exponent
 		size_t						_scalingsz;	// number of scaling coefficients
-		std::map<size_t, size_t>	_varc;		// map j -> variant coefficients
-		std::map<size_t, size_t>	_bands;		// map j -> indeces
+		std::vector<size_t>			_varc;		// j -> variant coefficients
+		std::vector<size_t>			_bands;		// j -> indeces
+		std::vector<size_t>			_scale;		// i -> scale j, flat table
+		std::vector<size_t>			_backsteps;	// i -> history backsteps
+		std::vector<uint64_t>		_svtmask;	// i -> SVT coefficient, one bit each
 
 		shift_variance_theorem(const size_t& Srcsize, const size_t& _WaveletN)
 			: _Srcsize(Srcsize)
@@ -33,6 +56,8 @@ namespace fast_wavelet_transform
 			_fill_variant_coefficients();
 
 			_fill_subbands();
+
+			_fill_tables();
 		}
 
 		~shift_variance_theorem()
@@ -41,17 +66,8 @@ namespace fast_wavelet_transform
 		bool is_scaling_coefficient(const size_t& i) const {return i<_scalingsz;}
 
 		bool is_SVT_coefficient(const size_t& i) const
-		{
-			// bool if a coefficient can be retrieved from previous wavelet transforms
-
-			try 
-			{
-				const size_t j(_index_to_scale(i));
-
-				return i < _bands.at(j - 1) - _variant_coefficients_size(j);
-			}
-
-			catch (...) {return false;}
+		{// bool if a coefficient can be retrieved from previous wavelet transforms
+			return i<_Srcsize && ((_svtmask[i>>6] >> (i&63)) & 1);
 		}
 
 		auto back_steps(const size_t& i) const ->size_t
@@ -59,7 +75,12 @@ namespace fast_wavelet_transform
 			// number of history backsteps required in order to...
 			// ... retrieve the coefficient in the rightish column
 			// ... of matrix Q
-			return (size_t)(std::pow(2, _index_to_scale(i)));
+			return i<_Srcsize? _backsteps[i]: 1;
+		}
+
+		auto scale(const size_t& i) const ->size_t
+		{// scale of a coefficient, the scaling coefficients share the deepest one
+			return i<_Srcsize? _scale[i]: 0;
 		}
 
 		auto maxj() const ->size_t {return _maxjexp;}
@@ -70,30 +91,42 @@ namespace fast_wavelet_transform
 
 		auto wavelet_support() const ->size_t {return _N;}
 
+		void svt_segments(std::vector<svt_segment>& _Segs, const size_t& _Pushed=0 /*rows pushed after the source one*/) const
+		{
+			// the SVT coefficients of a scale are contiguous, [_bands[j], _bands[j-1]-_varc[j]), 
+			// and all read from the row backsteps(j) behind the newest: one segment per scale
+
+			_Segs.clear();
+
+			for (size_t i = 0; i < _Srcsize; ++i)
+			{
+				if (!is_SVT_coefficient(i)) continue;
+
+				if (!_Segs.empty() && _Segs.back()._Scale == _scale[i] && _Segs.back()._First + _Segs.back()._Count == i) 
+					
+					++_Segs.back()._Count;
+
+				else _Segs.push_back(svt_segment{_scale[i], _backsteps[i] + _Pushed, i, 1});
+			}
+		}
+
 		void variant_coefficients(std::vector<size_t>& _VarCoeff) const
 		{
 			// extract the number of non-SVT coefficients... 
 			// see paper DSPX (table 1)
 
-			_VarCoeff.clear();
-
-			for (auto I= _varc.cbegin(), E= _varc.cend(); I!=E; ++I)
-				_VarCoeff.push_back(I->second);
+			_VarCoeff.assign(_varc.cbegin()+1, _varc.cend());
 		}
 
 	private:
 
-		auto _variant_coefficients_size(const size_t& j) const ->size_t
-		{
-			// return the number of shift-variant coefficients at scale 'j'
-			return _varc.at(j);
-		}
-
 		void _fill_subbands()
 		{
 			// fill the size of subbands
 			// see paper DSPX (eq. 12)
 
+			_bands.resize(_maxjexp+1);
+
 			for (size_t j = 0; j <= _maxjexp; ++j)
 			{
 				_bands[j] = (_Srcsize >> j);
@@ -105,6 +138,10 @@ namespace fast_wavelet_transform
 			// see paper DSPX (eq. system 13)
 			// Lemma on the number of variant coefficients
 
+			_varc.assign(_maxjexp+1, 0); // j=0 unused
+
+			if (!_maxjexp) return;
+
 			_varc[1] = _N; // see Nh/2
 
 			for (size_t i = 2; i <= _maxjexp; ++i)
@@ -112,13 +149,40 @@ namespace fast_wavelet_transform
 				_varc[i] = (_varc[i - 1] + 1) / 2 + (_varc[i - 1] + 1) % 2 + _N - 1;
 		}
 
-		auto _index_to_scale /*throws*/(const size_t& i) const ->size_t
-		{// throws if 'i' is a scaling coefficient
-			for (auto I = _bands.cbegin(), E = _bands.cend(); I != E; ++I)
+		void _fill_tables()
+		{
+			// per index scale, backsteps and SVT bit, queried per coefficient by the engine
+			// scale j of index i: _bands[j] <= i < _bands[j-1], i.e. log2(_Srcsize) - floor(log2(i))
+
+			const size_t _Log2Src(_log2(_Srcsize));
+
+			_scale.assign(_Srcsize, _maxjexp);
+
+			_backsteps.assign(_Srcsize, size_t(1) << _maxjexp);
+
+			_svtmask.assign((_Srcsize+63)/64, 0);
+
+			for (size_t i = _scalingsz; i < _Srcsize; ++i)
+			{
+				size_t j(_Log2Src - _log2(i));
+
+				j += ((_Srcsize >> j) > i); // source size not a power of 2
+
+				_scale[i] = j;
+
+				_backsteps[i] = size_t(1) << j;
+
+				if (i < _bands[j - 1] - _varc[j]) _svtmask[i>>6] |= uint64_t(1) << (i&63);
+			}
+		}
+
+		static auto _log2(size_t x) ->size_t
+		{// floor(log2(x)), x>0
+			size_t r(0);
 
-				if (I->second <= i) return I->first;
+			while (x >>= 1) ++r;
 
-			throw std::exception("DWT theorem: _index_to_scale - failed, index out of range");
+			return r;
 		}
 
 		auto _scaling_size() const ->size_t 
@@ -134,551 +198,1451 @@ namespace fast_wavelet_transform
 		}
 	};
 
-	struct DWT
+	template <class T>
+	struct DWT_t
 	{
-		typedef double									floating_point_type;
+		// interface of the transformers, T is the scalar type of sources and transforms
+
+		typedef T										floating_point_type;
 		typedef floating_point_type						value_type;
 		typedef value_type*								pointer;
 		typedef const value_type*						const_pointer;
 
 		typedef std::vector<value_type>					vector_type;
 		typedef std::vector<vector_type>				matrix_type;
+		typedef circular_matrix<value_type>				circular_matrix_type;
 
 
-		virtual ~DWT() {}
+		virtual ~DWT_t() {}
 
 		virtual auto size() const->size_t =0;
 
+		// allocation free: _Work holds workspace_size(N) values (see dwt_plan),
+		// the convenience overloads without it are at the end of the interface
+
+		virtual auto workspace_size(const size_t& /*source size*/) const ->size_t =0;
+
 		virtual void transform(const const_pointer&, 
-								const pointer&, const size_t&) const =0;
+								const pointer&, const size_t&, const pointer& /*workspace*/) const =0;
 
-		virtual void transform(const std::vector<size_t>& _VariantCoeff /*cached variant sizes*/,
-				const std::vector<size_t>& _Backsteps /*cached backsteps for theorem transposition*/,
+		virtual void transform(const size_t* _Imax /*theorem copies of each level*/,
+				const size_t* _Backsteps /*backsteps of each level*/,
 					const matrix_type& _Q /*const reference to matrix Q*/,
 						const const_pointer& _Src /*ptr to source series*/, 
 							const pointer& _Dest /*destination ptr to wavelet transform*/, 
-								const size_t& _N /*source size*/) const =0;
+								const size_t& _N /*source size*/, const pointer& _Work /*workspace*/) const =0;
+
+		virtual void transform(const size_t* _Imax /*theorem copies of each level*/,
+				const size_t* _Backsteps /*backsteps of each level*/,
+					const circular_matrix_type& _Q /*const reference to circular matrix Q*/,
+						const const_pointer& _Src /*ptr to source series*/, 
+							const pointer& _Dest /*destination ptr to wavelet transform*/, 
+								const size_t& _N /*source size*/, const pointer& _Work /*workspace*/) const =0;
 
 		virtual void invert(const const_pointer&, 
-							const pointer&, const size_t&) const =0;
+							const pointer&, const size_t&, const pointer& /*workspace*/) const =0;
 
-		virtual void coefficients(std::vector<value_type>&) const =0;
+		// batches: _Count windows, the k-th one at _Src + k*_Hop, transformed into 
+		// the rows of _Dest (_Count x source size, row major) on the calling thread; _Work holds
+		// batch_workspace_size(N) values. Threads: dwt_plan::execute_batch(), whole groups of batch_width() windows each
 
-		virtual auto wavelet_type() const ->std::string =0;
-	};
+		virtual auto batch_width() const ->size_t =0;
 
-	template <size_t _FilterN>
-	struct DWT_base : DWT
-	{
-		typedef std::array<floating_point_type, 2*_FilterN>		array_type;
+		virtual auto batch_workspace_size(const size_t& /*source size*/) const ->size_t =0;
 
-	protected:
+		virtual void transform_batch(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& /*source size*/, const size_t& _Count, 
+								const size_t& _Hop, const pointer& _Work) const =0;
 
-		template <class... _Coeff>
-		DWT_base(_Coeff... c)
-			: _CacheSz(2*_FilterN)
-			, _CacheBaseSz(static_cast<const size_t>(std::pow(2.0, std::ceil(std::log2(_CacheSz)))))
-			, _H({ c... }) 
-			, _G(_fillg())
-			, _Ih(_invertH())
-			, _Ig(_invertG())
-		{
-		}
+		// interleaved series: _Lanes series of the same size, the sample (coefficient) k of the l-th one 
+		// at [k*_Lanes+l], see multi_engine. _Work holds workspace_size(N)*_Lanes values
 
-		~DWT_base() {}
+		virtual void transform_interleaved(const const_pointer& /*sources*/, const pointer& /*transforms*/, 
+							const size_t& /*source size*/, const size_t& _Lanes, const pointer& _Work) const =0;
 
+		virtual void transform_interleaved(const size_t* _Imax /*theorem copies of each level*/,
+				const size_t* _Backsteps /*backsteps of each level*/,
+					const circular_matrix_type& _Q /*matrix Q, rows of source size*_Lanes interleaved coefficients*/,
+						const const_pointer& _Src /*interleaved sources*/, 
+							const pointer& _Dest /*interleaved transforms*/, 
+								const size_t& _N /*source size*/, const size_t& _Lanes, const pointer& _Work) const =0;
 
-	public:
+		virtual void invert_interleaved(const const_pointer& /*transforms*/, const pointer& /*sources*/, 
+							const size_t& /*source size*/, const size_t& _Lanes, const pointer& _Work) const =0;
 
-		virtual auto size() const ->size_t { return _CacheSz; }
+		// point inverses, _Work holds range_workspace_size(N) values: 
+		// under the lifting scheme the whole crystal is inverted, then the samples picked
 
+		virtual auto range_workspace_size(const size_t& /*source size*/) const ->size_t =0;
 
-		virtual void transform(const const_pointer& _Src, 
-				const pointer& _Dest, 
-					const size_t& _N) const
-		{
-			// Fast Wavelet Transform
-			// N must be a power of 2 
-			
-			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
+		virtual void invert_range(const const_pointer& /*crystal*/, const pointer& /*destination*/, 
+							const size_t& /*source size*/, const size_t& /*first sample*/, const size_t& /*last sample, excluded*/,
+								const pointer& /*workspace*/) const =0;
 
-			_transform(_Src, _Dest, _N); // e.g 128
+		virtual auto invert_point(const const_pointer& /*crystal*/, 
+							const size_t& /*source size*/, const size_t& /*sample*/, const pointer& /*workspace*/) const ->value_type =0;
 
-			for (size_t n=(_N>>1); n>=_CacheSz ; n>>=1) { // e.g. 64, 32, 16, 8, 4
+		virtual void support(const size_t& /*source size*/, const size_t& /*first sample*/, const size_t& /*last sample, excluded*/,
+							std::vector<size_t>& /*coefficient indices*/) const =0;
 
-				_transform(_Dest, _Dest /*overwrite*/, n);
+		virtual void coefficients(std::vector<value_type>&) const =0;
 
-				// 'dest' is transformed, only the first n coefficients
-				// are transformed. The rightish coefficients remain 
-				// those transformed the previous cycle.
-			}
-		}
+		virtual auto wavelet_type() const ->std::string =0;
 
+		virtual auto isa() const ->simd::isa_type =0;
 
-		virtual void transform(const std::vector<size_t>& _VariantCoeff /*cached variant sizes*/,
+		virtual void set_isa(const simd::isa_type&) =0;
+
+		virtual auto scheme() const ->scheme_type =0;
+
+		virtual void set_scheme(const scheme_type&) =0;
+
+
+		// convenience overloads: the workspace of the calling thread is grown to the 
+		// largest source size seen, never shrunk, no allocation per transform after that
+
+		void transform(const const_pointer& _Src, const pointer& _Dest, const size_t& _N) const
+		{
+			transform(_Src, _Dest, _N, _scratch(workspace_size(_N)));
+		}
+
+		void transform(const std::vector<size_t>& _VariantCoeff /*cached variant sizes*/,
 				const std::vector<size_t>& _Backsteps /*cached backsteps for theorem transposition*/,
 					const matrix_type& _Q /*const reference to matrix Q*/,
 						const const_pointer& _Src /*ptr to source series*/, 
 							const pointer& _Dest /*destination ptr to wavelet transform*/, 
 								const size_t& _N /*source size*/) const
 		{
-			// theorem Discrete Wavelet Transform of dyadic series
-			// N must be a power of 2 
-			
-			if (_N<_CacheSz ) throw std::exception("DWT failure, small range");
+			size_t _Imax[_MaxLevels];
 
+			_theorem_levels(_VariantCoeff, _N, _Imax);
 
-			const size_t _history_size(_Q.size());	// no. of rows of matrix Q
+			transform(_Imax, &_Backsteps[0], _Q, _Src, _Dest, _N, _scratch(workspace_size(_N)));
+		}
 
-			size_t _Half(_N >> 1);	// cache 
+		void transform(const std::vector<size_t>& _VariantCoeff /*cached variant sizes*/,
+				const std::vector<size_t>& _Backsteps /*cached backsteps for theorem transposition*/,
+					const circular_matrix_type& _Q /*const reference to circular matrix Q*/,
+						const const_pointer& _Src /*ptr to source series*/, 
+							const pointer& _Dest /*destination ptr to wavelet transform*/, 
+								const size_t& _N /*source size*/) const
+		{
+			size_t _Imax[_MaxLevels];
 
-			size_t j(0);	// iteration index
+			_theorem_levels(_VariantCoeff, _N, _Imax);
 
-			const size_t* _VarCoeffptr(&_VariantCoeff[0]), 
-				*_Backsteps_ptr(&_Backsteps[0]); // readonly ptrs 
-		
-			size_t _Imax(_N - *_VarCoeffptr - _Half);	// max iteration for theorem copy operations
+			transform(_Imax, &_Backsteps[0], _Q, _Src, _Dest, _N, _scratch(workspace_size(_N)));
+		}
 
-			vector_type::const_pointer	// readony Q ptr
-				_Qptr(&_Q[_history_size - *_Backsteps_ptr -1][_Half+1]);	
+		void invert(const const_pointer& _Src, const pointer& _Dest, const size_t& _N) const
+		{
+			invert(_Src, _Dest, _N, _scratch(workspace_size(_N)));
+		}
 
-			vector_type::pointer	// write ptrs to destination DWT
-				_Details_ptr(&_Dest[_Half]), 
-					_Difference_ptr(&_Dest[0]);	
+		void transform_batch(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const size_t& _Count, const size_t& _Hop) const
+		{
+			transform_batch(_Src, _Dest, _N, _Count, _Hop, _scratch(batch_workspace_size(_N)));
+		}
 
+		void invert_range(const const_pointer& _Src, const pointer& _Dest, 
+						const size_t& _N, const size_t& _First, const size_t& _Last) const
+		{
+			invert_range(_Src, _Dest, _N, _First, _Last, _scratch(range_workspace_size(_N)));
+		}
 
-			// theorem copy...
-			for (size_t i=0; i<_Imax; 
-					++i, ++_Difference_ptr, ++++j)
-			{
-				// fast copy theorem coefficients...
-				*_Details_ptr++ = *_Qptr++;		
+		auto invert_point(const const_pointer& _Src, const size_t& _N, const size_t& i) const ->value_type
+		{
+			return invert_point(_Src, _N, i, _scratch(range_workspace_size(_N)));
+		}
 
-				for (size_t z=0; z < _CacheSz ; ++z)
-				
-					*_Difference_ptr += _Src[j + z] * _H[z]; // convolve source and scaling			 
-			}
-			
-			// non theorem transform steps (final for the first resolution step)...
-			size_t _VariantSteps(_N/2-_Imax);
+	protected:
 
-			for (size_t y=0; y<_VariantSteps; 
-					++y, ++_Details_ptr, ++_Difference_ptr, ++++j)
+		static const size_t	_MaxLevels = 64;	// bound to the no. of DWT levels
 
-				for (size_t z=0; z<_CacheSz; ++z)
-				{
-					*_Difference_ptr += _Src[(j+z)%_N] * _H[z]; // convolve source and scaling
-						
-					*_Details_ptr += _Src[(j+z)%_N] * _G[z]; // convolve source and wavelet
-				}
+		void _theorem_levels(const std::vector<size_t>& _VariantCoeff, const size_t& _N, size_t* _Imax) const
+		{// theorem copies of each level of the reduced transform: 128, 64, ... > base size (next pwr of 2 of size())
 
+			size_t _BaseSz(1);
 
-			// start deeper scales transformation... >>>>>
+			while (_BaseSz<size()) _BaseSz<<=1;
 
-			++_VarCoeffptr; ++_Backsteps_ptr; // next variant coeff size and backstep
+			for (size_t k=0, n=_N; !k || n>_BaseSz; ++k, n>>=1) 
+				
+				_Imax[k] = n - _VariantCoeff[k] - (n>>1);
+		}
 
-			size_t n(_N>>1);	// cache
+		static auto _scratch(const size_t& _Sz) ->pointer
+		{// workspace of the calling thread, shared by the transformers of type T
+			thread_local std::vector<value_type> _Work;
 
-			std::vector<value_type> _Tmp(n); // temporary depot vector
+			if (_Work.size()<_Sz) _Work.resize(_Sz);
 
-			for (; n>_CacheBaseSz; n>>=1, 
-				++_VarCoeffptr, ++_Backsteps_ptr) 
-			{// e.g. 64, 32, 16, 8, 4
+			return &_Work[0];
+		}
+	};
 
-				_Half = n >> 1;
+	template <class T> const size_t DWT_t<T>::_MaxLevels;
 
-				_Tmp.assign(n, 0);
+	typedef DWT_t<double>	DWT;
 
-				vector_type::const_pointer	// read only
-					_Qptr(&_Q[_history_size - *_Backsteps_ptr -1][_Half+1]);	
-	
-				_Details_ptr=&_Tmp[_Half]; _Difference_ptr=&_Tmp[0];
+	template <size_t _Z, size_t _End>
+	struct unrolled
+	{
+		// convolution taps unrolled at compile time, summed in the order z= _Z, _Z+1, ... _End-1
 
-				_Imax=n-(*_VarCoeffptr)-_Half;
+		template <class T, class _Filter>
+		static void dot(const T* _Src, const _Filter& _H, T& _A)
+		{
+			_A += _Src[_Z]*_H[_Z];
 
-				j=0;
+			unrolled<_Z+1, _End>::dot(_Src, _H, _A);
+		}
 
-				for (size_t i=0; i<_Imax; 
-						++i, ++_Difference_ptr, ++++j)
-				{
-					// fast copy coroll coeff...
-					*_Details_ptr++ = *_Qptr++;		
+		template <class T, class _Filter>
+		static void dot2(const T* _Src, const _Filter& _H, const _Filter& _G, T& _A, T& _D)
+		{// scaling and wavelet at once
+			_A += _Src[_Z]*_H[_Z];
 
-					for (size_t z=0; z<_CacheSz ; ++z)
+			_D += _Src[_Z]*_G[_Z];
 
-						*_Difference_ptr += _Dest[j + z] * _H[z];
-				}
+			unrolled<_Z+1, _End>::dot2(_Src, _H, _G, _A, _D);
+		}
 
-				_VariantSteps=n/2-_Imax;
+		template <class T, class _Filter>
+		static void dot_pairs(const T* _Lo, const T* _Hi, const _Filter& _I, T& _A)
+		{// inverse step, interleaved filter
+			_A += _Lo[_Z]*_I[2*_Z] + _Hi[_Z]*_I[2*_Z+1];
 
-				for (size_t y=0; y<_VariantSteps; 
-						++y, ++_Details_ptr, ++_Difference_ptr, ++++j)
+			unrolled<_Z+1, _End>::dot_pairs(_Lo, _Hi, _I, _A);
+		}
+	};
 
-					for (size_t z=0; z<_CacheSz ; ++z)
-					{
-						*_Difference_ptr += _Dest[(j + z) % n] * _H[z]; // convolve...
+	template <size_t _End>
+	struct unrolled <_End, _End>
+	{
+		template <class T, class _Filter>
+		static void dot(const T*, const _Filter&, T&) {}
 
-						*_Details_ptr += _Dest[(j + z) % n] * _G[z]; // convolve...
-					}
+		template <class T, class _Filter>
+		static void dot2(const T*, const _Filter&, const _Filter&, T&, T&) {}
 
-				// partial copy to effective destination...
-				std::copy(_Tmp.cbegin(), n+_Tmp.cbegin(), _Dest);
-			}
+		template <class T, class _Filter>
+		static void dot_pairs(const T*, const T*, const _Filter&, T&) {}
+	};
 
+	inline constexpr auto next_pow2(const size_t n, const size_t p=1) ->size_t 
+	{
+		return (p>=n)? p: next_pow2(n, p<<1);
+	}
 
-			// phi coefficients of the wavelet series... >>>>>>
+	template <class _Bank, size_t _FilterN, class T=double>
+	struct filter_bank
+	{
+		// the filters of a wavelet, derived at compile time from its scaling filter _Bank::h(),
+		// tabulated in double and rounded once to T
 
-			_Half = n >> 1;	// cache
+		typedef std::array<T, 2*_FilterN>		array_type;
 
-			_Tmp.assign(n, 0);
-	
-			_Imax=n/2;
+		static constexpr auto h() ->array_type { return _h(std::make_index_sequence<2*_FilterN>()); }
 
-			_Details_ptr=&_Tmp[_Half]; _Difference_ptr=&_Tmp[0];
+		static constexpr auto g() ->array_type { return _g(std::make_index_sequence<2*_FilterN>()); }
 
-			j=0;
+		static constexpr auto ih() ->array_type { return _ih(std::make_index_sequence<2*_FilterN>()); }
 
-			for (size_t y=0; y<_Imax; 
-				++y, ++_Details_ptr, ++_Difference_ptr, ++++j)
+		static constexpr auto ig() ->array_type { return _ig(std::make_index_sequence<2*_FilterN>()); }
 
-				for (size_t z=0; z<_CacheSz ; ++z)
-				{
-					*_Difference_ptr += _Dest[(j + z) % n] * _H[z]; // convolve...
+	private:
 
-					*_Details_ptr += _Dest[(j + z) % n] * _G[z]; // convolve...
-				}
+		static constexpr auto _at(const array_type& _F, const size_t i) ->T { return _F[i]; }
 
+		static constexpr auto _round(const std::array<double, 2*_FilterN>& _F, const size_t i) ->T { return static_cast<T>(_F[i]); }
 
-			// final transfer to effective destination vector...
-			std::copy(_Tmp.cbegin(), n+_Tmp.cbegin(), _Dest);
+		template <size_t... I>
+		static constexpr auto _h(std::index_sequence<I...>) ->array_type
+		{
+			return {{ _round(_Bank::h(), I)... }};
 		}
 
-		void invert(const const_pointer& _Src, const pointer& _Dest, 
-						const size_t& _N) const
+		// Daubechies, "Orthonormal bases of compactly supported wavelets"
+		// equations 3.17, 3.45: g[i]= (-1)^i h[L-i-1]
+
+		template <size_t... I>
+		static constexpr auto _g(std::index_sequence<I...>) ->array_type
 		{
-			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
+			return {{ ((I&1)? -_at(h(), 2*_FilterN -I-1): _at(h(), 2*_FilterN -I-1))... }};
+		}
 
-			std::copy(_Src, _Src+_N, _Dest);
+		// inverted H and G, based on h and g: columns of the forward matrix, 
+		// starting from the first index which covers all the necessary 
+		// forward passages (see matrix at pos.2)
 
-			for (size_t n=_CacheBaseSz; n<=_N; n<<=1)
-			{// 4, 8, 16, ...128
-				_invTransform(_Dest, n);
-			}
+		template <size_t... I>
+		static constexpr auto _ih(std::index_sequence<I...>) ->array_type
+		{// even: h[istart-i], odd: g[istart-i+1]
+			return {{ ((I&1)? _at(g(), 2*_FilterN -1-I): _at(h(), 2*_FilterN -2-I))... }};
 		}
 
-		void coefficients(std::vector<floating_point_type>& _Out) const
-		{
-			// export wavelet coefficients in _Out
-			_Out.clear();
-
-			_Out.insert(_Out.end(), _H.cbegin(), _H.cend());
-			_Out.insert(_Out.end(), _G.cbegin(), _G.cend());
-			_Out.insert(_Out.end(), _Ih.cbegin(), _Ih.cend());
-			_Out.insert(_Out.end(), _Ig.cbegin(), _Ig.cend());
+		template <size_t... I>
+		static constexpr auto _ig(std::index_sequence<I...>) ->array_type
+		{// same as _ih(), next column of the matrix
+			return {{ ((I&1)? _at(g(), 2*_FilterN -I): _at(h(), 2*_FilterN -1-I))... }};
 		}
+	};
 
-	private:
+	template <size_t _FilterN, class _Bank, class T=double>
+	struct DWT_base : DWT_t<T>
+	{
+		// _Bank::h() is the scaling filter, the filter bank is built at compile time
 
-		void _transform(const const_pointer& _Src, const pointer& _Dest, 
-							const size_t& _N) const
-		{
-			const size_t _Rs(_CacheSz /2 -1); // remaining steps
+		typedef DWT_t<T>										base_type;
+		typedef typename base_type::floating_point_type			floating_point_type;
+		typedef typename base_type::value_type					value_type;
+		typedef typename base_type::pointer						pointer;
+		typedef typename base_type::const_pointer				const_pointer;
+		typedef typename base_type::vector_type					vector_type;
+		typedef typename base_type::matrix_type					matrix_type;
+		typedef typename base_type::circular_matrix_type		circular_matrix_type;
 
-			const size_t _Half(_N >> 1);
+		typedef std::array<floating_point_type, 2*_FilterN>		array_type;
 
-			std::vector<value_type> _Tmp(_N);
+		using base_type::transform;		// and the other convenience overloads, see DWT_t
+		using base_type::invert;
+		using base_type::transform_batch;
+		using base_type::invert_range;
+		using base_type::invert_point;
 
-			size_t i(0), j(0);
+	protected:
 
-			for (; j<=_N-_CacheSz +1; ++i, ++++j)
-			{
-				for (size_t z=0; z<_CacheSz ; ++z)
-				{
-					_Tmp[i]      += _Src[j+z]*_H[z]; // convolve source and scaling
+		DWT_base()
+			: _Isa(simd::detect_isa())
+			, _Scheme(scheme_convolution)
+		{
+		}
 
-					_Tmp[i+_Half] += _Src[j+z]*_G[z]; // convolve source and wavelet
-				}
-			}
+		~DWT_base() {}
 
-			for (size_t y=_Rs; y>0; --y, ++i, ++++j)
-			{// trepassing series borders
-				for (size_t z=0; z<_CacheSz ; ++z)
-				{
-					_Tmp[i]      += _Src[(j+z)%_N]*_H[z]; // convolve...
 
-					_Tmp[i+_Half] += _Src[(j+z)%_N]*_G[z]; // convolve...
-				}
-			}
+	public:
+
+		virtual auto size() const ->size_t { return _CacheSz; }
 
-			std::copy(_Tmp.cbegin(), _Tmp.cend(), _Dest);
+		virtual auto isa() const ->simd::isa_type { return _Isa; }
+
+		virtual void set_isa(const simd::isa_type& _I) 
+		{// select the convolution kernels, bounded to the instruction sets of this CPU
+			_Isa = (_I > simd::detect_isa())? simd::detect_isa(): _I;
 		}
 
-		void _invTransform(const pointer& _Dest, const size_t& _N) const
+		virtual auto scheme() const ->scheme_type { return _Scheme; }
+
+		virtual void set_scheme(const scheme_type& _S) { _Scheme=_S; } // convolution or lifting steps
+
+
+		virtual auto workspace_size(const size_t& _N) const ->size_t { return _N + 2*_FilterN; }
+
+		virtual auto range_workspace_size(const size_t& _N) const ->size_t { return std::max(workspace_size(_N), 2*_N); }
+
+
+		virtual void transform(const const_pointer& _Src, 
+				const pointer& _Dest, 
+					const size_t& _N, const pointer& _Work) const
 		{
-			const size_t _Is(_CacheSz/2 -1); // initial steps
+			// Fast Wavelet Transform
+			// N must be a power of 2 
+			
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
 
-			const size_t _Half(_N>>1);
+			if (_Scheme==scheme_lifting) { _lifting_transform(_Src, _Dest, _N, _Work); return; }
 
-			std::vector<value_type> _Tmp(_N);
+			if (_Isa!=simd::isa_scalar) { _simd_transform(_Src, _Dest, _N, _Work); return; }
 
-			size_t j(0);
+			_transform(_Src, _Dest, _N, _Work); // e.g 128
 
-			for (size_t y=_Is; y>0; --y, ++++j)
-			{// e.g. y= 3,2,1
+			for (size_t n=(_N>>1); n>=_CacheSz ; n>>=1) { // e.g. 64, 32, 16, 8, 4
 
-				for (size_t z=0; z<_FilterN /*_CacheSz/2*/; ++z)
-				{// e.g. z=0,1,2,3
-					
-					const size_t _left((_Half-y+z)%_Half);
-				
-					const size_t _right(((_Half-y+z)%_Half)+_Half);
+				_transform(_Dest, _Dest /*overwrite*/, n, _Work);
 
-					_Tmp[j] += _Dest[_left]*_Ih[2*z] + _Dest[_right]*_Ih[2*z+1];
-				
-					_Tmp[j+1] += _Dest[_left]*_Ig[2*z] + _Dest[_right]*_Ig[2*z+1];
-				}
+				// 'dest' is transformed, only the first n coefficients
+				// are transformed. The rightish coefficients remain 
+				// those transformed the previous cycle.
 			}
+		}
+
+
+		virtual void transform(const size_t* _Imax /*theorem copies of each level*/,
+				const size_t* _Backsteps /*backsteps of each level*/,
+					const matrix_type& _Q /*const reference to matrix Q*/,
+						const const_pointer& _Src /*ptr to source series*/, 
+							const pointer& _Dest /*destination ptr to wavelet transform*/, 
+								const size_t& _N /*source size*/, const pointer& _Work /*workspace*/) const
+		{
+			_theorem_transform(_Imax, _Backsteps, _Q, _Src, _Dest, _N, _Work);
+		}
+
+		virtual void transform(const size_t* _Imax /*theorem copies of each level*/,
+				const size_t* _Backsteps /*backsteps of each level*/,
+					const circular_matrix_type& _Q /*const reference to circular matrix Q*/,
+						const const_pointer& _Src /*ptr to source series*/, 
+							const pointer& _Dest /*destination ptr to wavelet transform*/, 
+								const size_t& _N /*source size*/, const pointer& _Work /*workspace*/) const
+		{
+			_theorem_transform(_Imax, _Backsteps, _Q, _Src, _Dest, _N, _Work);
+		}
+
+		virtual auto batch_width() const ->size_t
+		{// windows of a group of transform_batch(), one per vector lane
 			
-			for (size_t i=0; i<_Half-_Is; ++i, ++++j)
+			if (_Scheme==scheme_lifting) return 1;
+
+			switch (_Isa)
 			{
-				for (size_t z=0; z<_FilterN /*_CacheSz/2*/; ++z)
-				{// e.g. z=0,1,2,3
-					_Tmp[j] += _Dest[i+z]*_Ih[2*z] + _Dest[i+_Half+z]*_Ih[2*z+1];
-				
-					_Tmp[j+1] += _Dest[i+z]*_Ig[2*z] + _Dest[i+_Half+z]*_Ig[2*z+1];
-				}
+				case simd::isa_avx512: return simd::batch_kernels<simd::isa_avx512, _FilterN, T>::width;
+				case simd::isa_avx2: return simd::batch_kernels<simd::isa_avx2, _FilterN, T>::width;
+				default: break;
 			}
 
-			std::copy(_Tmp.cbegin(), _Tmp.cend(), _Dest);
+			return 1;
 		}
 
+		virtual auto batch_workspace_size(const size_t& _N) const ->size_t
+		{// a group interleaved, its wrapped tail and its transform, then the window workspace
+			return (2*_N + _CacheSz-2)*batch_width() + workspace_size(_N);
+		}
 
-		array_type _fillg() const 
+		virtual void transform_batch(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const size_t& _Count, 
+								const size_t& _Hop, const pointer& _Work) const
 		{
-			// Daubechies, "Orthonormal bases of compactly supported wavelets"
-			// equations 3.17, 3.45
+			// batched Fast Wavelet Transform, bit identical to transform() of each window:
+			// the convolution runs on groups of interleaved windows
 
-			array_type _D;
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
 
-			for (size_t i=0; i<_CacheSz ; ++i) 
-				
-				_D[i] = std::pow(-1, i) * _H[_CacheSz -i-1];
+			if (batch_width()>1) switch (_Isa)
+			{
+				case simd::isa_avx512: _batch_groups<simd::isa_avx512>(_Src, _Dest, _N, _Count, _Hop, _Work); return;
+				case simd::isa_avx2: _batch_groups<simd::isa_avx2>(_Src, _Dest, _N, _Count, _Hop, _Work); return;
+				default: break;
+			}
 
-			return _D;
+			for (size_t w=0; w<_Count; ++w) transform(_Src + w*_Hop, _Dest + w*_N, _N, _Work);
 		}
 
-		array_type _invertH() const
-		{// create inverted H based on h and g
+		virtual void transform_interleaved(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const size_t& _Lanes, const pointer& _Work) const
+		{
+			// Fast Wavelet Transform of interleaved series, the lanes of the vectors span the series:
+			// bit identical to the convolution transform() of each series
+
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
 
-			// Retrieve the first index which covers all 
-			// the necessary forward passages to be able 
-			// to perform an inverted passage 
-			// (see matrix at pos.2)
+			_lanes_level(_Src, _Dest, _N, _Lanes, _Work);
 
-			const size_t istart = 2* (_CacheSz /2 -1);
+			for (size_t n=(_N>>1); n>=_CacheSz ; n>>=1) _lanes_level(_Dest, _Dest, n, _Lanes, _Work);
+		}
 
-			array_type _D;
+		virtual void transform_interleaved(const size_t* _Imax_ptr /*theorem copies of each level*/,
+				const size_t* _Backsteps_ptr /*backsteps of each level*/,
+					const circular_matrix_type& _Q /*matrix Q, rows of source size*_Lanes interleaved coefficients*/,
+						const const_pointer& _Src /*interleaved sources*/, 
+							const pointer& _Dest /*interleaved transforms*/, 
+								const size_t& _N /*source size*/, const size_t& _Lanes, const pointer& _Work) const
+		{
+			// theorem transform of interleaved series, see _simd_theorem_transform(): 
+			// the theorem copies of a level are contiguous, _Imax*_Lanes values
 
-			for (size_t i=0, z=istart; i<_CacheSz ; i+=2, z-=2)
-			{	// difficult to comment in words, check anonymous 
-				//namespace, matrix at col.2 (vertical iteration)
-				_D[i]=_H[z];
+			const_pointer _In(_Src);
 
-				_D[i+1]=_G[z];
-			}
+			size_t n(_N), j(1);
 
-			return _D;
-		}
+			for (; n>_CacheBaseSz; n>>=1, ++j, _In=_Dest,
+				++_Imax_ptr, ++_Backsteps_ptr) 
+			{// e.g. 128, 64, 32, 16, 8
 
-		array_type _invertG() const
-		{// create inverted H based on h and g
+				const size_t _Half(n >> 1), _Imax(*_Imax_ptr);
 
-			// same as _invertH()
-			const size_t istart = 2* (_CacheSz /2 -1);
+				_lanes_extend(_In, n, _Lanes, _Work);
 
-			array_type _D;
+				// theorem copy, the newest row of Q excluded (see svt_segment)...
+				theorem_copy(_Q, svt_segment{j, *_Backsteps_ptr + 1, _Half, _Imax}, _Dest, _Lanes);
 
-			for (size_t i=0, z=istart; i<_CacheSz ; i+=2, z-=2)
-			{	// same as invertH(), except that we take elements 
-				// from the next column of the matrix
-				_D[i]=_H[z+1];
+				// ... then scaling convolution of the invariant part, full convolution of the variant one
+				simd::lane_kernels<_FilterN, T>::analysis_low(_Isa, _Work, _Lanes, &_H[0], _Dest, _Imax);
 
-				_D[i+1]=_G[z+1];
+				simd::lane_kernels<_FilterN, T>::analysis(_Isa, _Work + 2*_Imax*_Lanes, _Lanes, &_H[0], &_G[0], 
+					_Dest + _Imax*_Lanes, _Dest + (_Half + _Imax)*_Lanes, _Half - _Imax);
 			}
 
-			return _D;
+			// phi coefficients of the wavelet series
+			_lanes_level(_In, _Dest, n, _Lanes, _Work);
 		}
 
+		virtual void invert_interleaved(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const size_t& _Lanes, const pointer& _Work) const
+		{// inverse of transform_interleaved()
 
-		const size_t		_CacheSz;
-		const size_t		_CacheBaseSz;	// next pwr of 2
-		const array_type	_H;
-		const array_type	_G;
-		const array_type	_Ih;
-		const array_type	_Ig;
-	};
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
 
-	template <size_t N>
-	struct Daubechies_commnon : DWT_base<N>
-	{
-		template <class... _Coeff>
-		Daubechies_commnon(_Coeff... c) 
-			: DWT_base(c...) 
-		{
-			_Name << "Daubechies " << N;
-		}
+			std::copy(_Src, _Src+_N*_Lanes, _Dest);
 
-		~Daubechies_commnon() {}
+			for (size_t n=_CacheBaseSz; n<=_N; n<<=1) 
+			{// 4, 8, 16, ...128
 
+				const size_t _Is(_FilterN -1), _Half(n>>1), _Len(_Half + _FilterN -1);
 
-		virtual auto wavelet_type() const ->std::string {return _Name.str();}
+				const pointer _Lo(_Work), _Hi(_Work + _Len*_Lanes);
 
-	private:
+				simd::rotate_rows(_Dest, _Half, _Is, _Lanes, _Lo, _Len);
 
-		std::ostringstream _Name;
-	};
+				simd::rotate_rows(_Dest + _Half*_Lanes, _Half, _Is, _Lanes, _Hi, _Len);
 
-	template <size_t N>
-	struct Daubechies /*undef*/;
+				simd::lane_kernels<_FilterN, T>::synthesis(_Isa, _Lo, _Hi, _Lanes, &_Ih[0], &_Ig[0], _Dest, _Half);
+			}
+		}
+
+		void invert(const const_pointer& _Src, const pointer& _Dest, 
+						const size_t& _N, const pointer& _Work) const
+		{
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
+
+			std::copy(_Src, _Src+_N, _Dest);
+
+			if (_Scheme==scheme_lifting)
+			{
+				for (size_t n=_CacheBaseSz; n<=_N; n<<=1) _lifting().synthesis(_Dest, n, _Work);
+
+				return;
+			}
+
+			if (_Isa!=simd::isa_scalar) 
+			{
+				for (size_t n=_CacheBaseSz; n<=_N; n<<=1) _simd_invTransform(_Dest, n, _Work);
+
+				return;
+			}
+
+			for (size_t n=_CacheBaseSz; n<=_N; n<<=1)
+			{// 4, 8, 16, ...128
+				_invTransform(_Dest, n, _Work);
+			}
+		}
+
+		void invert_range(const const_pointer& _Src, const pointer& _Dest, 
+						const size_t& _N, const size_t& _First, const size_t& _Last, const pointer& _Work) const
+		{
+			// point inverse: reconstruct the samples [_First, _Last) only, into _Dest[0, _Last-_First).
+			// Each level visits just the window of coefficients the range depends on,
+			// the result is bit identical to the same samples of invert().
+			// _Work holds range_workspace_size(N) values: the windows below the top level, N/2 at most each;
+			// the lifting steps have no such windows, the crystal is inverted in _Work[0, N) instead
+
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
+
+			if (_First>=_Last || _Last>_N) throw std::exception("DWT failure, bad inversion range");
+
+			if (_Scheme==scheme_lifting)
+			{// as invert(), the samples of the range picked
+				std::copy(_Src, _Src+_N, _Work);
+
+				for (size_t n=_CacheBaseSz; n<=_N; n<<=1) _lifting().synthesis(_Work, n, _Work+_N);
+
+				std::copy(_Work+_First, _Work+_Last, _Dest);
+
+				return;
+			}
+
+			size_t _Start[_MaxLevels+1], _Len[_MaxLevels+1]; // windows of each level, top-down
+
+			const size_t _Levels(_point_windows(_N, _First, _Last, _Start, _Len));
+
+			// widest window below the top level
+			const size_t _Bufsz(*std::max_element(_Len+1, _Len+_Levels+1));
+
+			pointer _Lo(_Work), _Hi(_Work+_Bufsz);
+
+			// deepest window, read from the scaling coefficients
+			size_t n(_CacheBaseSz), _Half(n>>1);
+
+			for (size_t t=0, i=_Start[_Levels]; t<_Len[_Levels]; ++t, ++i)
+			{
+				if (i==_Half) i=0;
+
+				_Lo[t]=_Src[i];
+			}
+
+			for (size_t k=_Levels; k>0; --k, n<<=1, _Half=n>>1)
+			{// bottom-up, one level each step: 4, 8, 16, ... 128, the top one into _Dest
+
+				_invWindow(_Lo, _Start[k], _Len[k], _Src+_Half /*details*/, 
+					(k==1)? _Dest: _Hi, _Start[k-1], _Len[k-1], n);
+
+				std::swap(_Lo, _Hi);
+			}
+		}
+
+		auto invert_point(const const_pointer& _Src, 
+						const size_t& _N, const size_t& i, const pointer& _Work) const ->value_type
+		{// reconstruct the single sample i, see invert_range()
+
+			value_type _Out(0);
+
+			invert_range(_Src, &_Out, _N, i, i+1, _Work);
+
+			return _Out;
+		}
+
+		void support(const size_t& _N, const size_t& _First, const size_t& _Last,
+						std::vector<size_t>& _Coeff) const
+		{
+			// export in _Coeff, ascending, the indices of the coefficients 
+			// the samples [_First, _Last) of the inverse DWT depend on
+
+			if (_N<_CacheSz) throw std::exception("DWT failure, small range");
+
+			if (_First>=_Last || _Last>_N) throw std::exception("DWT failure, bad inversion range");
+
+			size_t _Start[_MaxLevels+1], _Len[_MaxLevels+1];
+
+			const size_t _Levels(_point_windows(_N, _First, _Last, _Start, _Len));
+
+			_Coeff.clear();
+
+			size_t n(_CacheBaseSz), _Half(n>>1);
+
+			for (size_t t=0, i=_Start[_Levels]; t<_Len[_Levels]; ++t, ++i)
+			{// scaling coefficients
+				if (i==_Half) i=0;
+
+				_Coeff.push_back(i);
+			}
+
+			for (size_t k=_Levels; k>0; --k, n<<=1, _Half=n>>1)
+			{// details read by each level, same window as the approximations
+				for (size_t t=0, i=_Start[k]; t<_Len[k]; ++t, ++i)
+				{
+					if (i==_Half) i=0;
+
+					_Coeff.push_back(_Half+i);
+				}
+			}
+
+			std::sort(_Coeff.begin(), _Coeff.end());
+		}
+
+		void coefficients(std::vector<floating_point_type>& _Out) const
+		{
+			// export wavelet coefficients in _Out
+			_Out.clear();
+
+			_Out.insert(_Out.end(), _H.cbegin(), _H.cend());
+			_Out.insert(_Out.end(), _G.cbegin(), _G.cend());
+			_Out.insert(_Out.end(), _Ih.cbegin(), _Ih.cend());
+			_Out.insert(_Out.end(), _Ig.cbegin(), _Ig.cend());
+		}
+
+	private:
+
+		template <class _Matrix>
+		void _theorem_transform(const size_t* _Imax /*theorem copies of each level*/,
+				const size_t* _Backsteps /*backsteps of each level*/,
+					const _Matrix& _Q /*matrix Q, vector of rows or circular_matrix*/,
+						const const_pointer& _Src /*ptr to source series*/, 
+							const pointer& _Dest /*destination ptr to wavelet transform*/, 
+								const size_t& _N /*source size*/, const pointer& _Work /*workspace*/) const
+		{
+			// theorem Discrete Wavelet Transform of dyadic series
+			// N must be a power of 2 
+			
+			if (_N<_CacheSz ) throw std::exception("DWT failure, small range");
+
+			if (_Scheme==scheme_lifting)
+			{
+				_lifting_theorem_transform(_Imax, _Backsteps, _Q, _Src, _Dest, _N, _Work); 
+				
+				return;
+			}
+
+			if (_Isa!=simd::isa_scalar) 
+			{
+				_simd_theorem_transform(_Imax, _Backsteps, _Q, _Src, _Dest, _N, _Work); 
+				
+				return;
+			}
+
+
+			size_t _Half(_N >> 1);	// cache 
+
+			size_t j(0), _Scale(1);	// iteration index, scale
+
+			const size_t* _Imax_ptr(_Imax),	// max iteration for theorem copy operations
+				*_Backsteps_ptr(_Backsteps); // readonly ptrs 
+
+			pointer	// write ptr to destination DWT
+				_Difference_ptr(&_Dest[0]);	
+
+
+			// theorem copy, the newest row of Q excluded (see svt_segment)...
+			theorem_copy(_Q, svt_segment{_Scale, *_Backsteps_ptr + 1, _Half, *_Imax_ptr}, _Dest);
+
+			// ... then the scaling convolution of the invariant part
+			for (size_t i=0; i<*_Imax_ptr; 
+					++i, ++_Difference_ptr, ++++j)
+			{
+				unrolled<0, _CacheSz>::dot(_Src+j, _H, *_Difference_ptr); // convolve source and scaling
+			}
+			
+			// non theorem transform steps (final for the first resolution step)...
+			size_t _VariantSteps(_N/2-*_Imax_ptr);
+
+			_convolve(_Src, _N, j, _Difference_ptr, &_Dest[_Half + *_Imax_ptr], _VariantSteps);
+
+
+			// start deeper scales transformation... >>>>>
+
+			++_Imax_ptr; ++_Backsteps_ptr; ++_Scale; // next theorem copy size and backstep
+
+			size_t n(_N>>1);	// cache
+
+			const pointer _Tmp(_Work); // temporary depot
+
+			for (; n>_CacheBaseSz; n>>=1, 
+				++_Imax_ptr, ++_Backsteps_ptr, ++_Scale) 
+			{// e.g. 64, 32, 16, 8, 4
+
+				_Half = n >> 1;
+
+				std::fill(_Tmp, _Tmp+n, value_type(0));
+
+				// fast copy coroll coeff...
+				theorem_copy(_Q, svt_segment{_Scale, *_Backsteps_ptr + 1, _Half, *_Imax_ptr}, _Tmp);
 	
+				_Difference_ptr=&_Tmp[0];
+
+				j=0;
+
+				for (size_t i=0; i<*_Imax_ptr; 
+						++i, ++_Difference_ptr, ++++j)
+				{
+					unrolled<0, _CacheSz>::dot(_Dest+j, _H, *_Difference_ptr);
+				}
+
+				_VariantSteps=n/2-*_Imax_ptr;
+
+				_convolve(_Dest, n, j, _Difference_ptr, &_Tmp[_Half + *_Imax_ptr], _VariantSteps);
+
+				// partial copy to effective destination...
+				std::copy(_Tmp, _Tmp+n, _Dest);
+			}
+
+
+			// phi coefficients of the wavelet series... >>>>>>
+
+			_Half = n >> 1;	// cache
+
+			_convolve(_Dest, n, 0, _Tmp, _Tmp+_Half, _Half);
+
+
+			// final transfer to effective destination vector...
+			std::copy(_Tmp, _Tmp+n, _Dest);
+		}
+
+		static auto _lifting() ->const lifting::factorization_t<T>&
+		{// lifting steps of the filter bank, factored on first use from the double tables
+			static const lifting::factorization_t<T> _F(&filter_bank<_Bank, _FilterN>::h()[0], _CacheSz);
+
+			return _F;
+		}
+
+		void _lifting_transform(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const pointer& _Work) const
+		{// transform() by lifting steps
+
+			_lifting().analysis(_Src, _N, _Work, _Dest, 0);
+
+			for (size_t n=(_N>>1); n>=_CacheSz ; n>>=1) _lifting().analysis(_Dest, n, _Work, _Dest, 0);
+		}
+
+		template <class _Matrix>
+		void _lifting_theorem_transform(const size_t* _Imax_ptr, 
+				const size_t* _Backsteps_ptr, const _Matrix& _Q,
+					const const_pointer& _Src, const pointer& _Dest, const size_t& _N, 
+						const pointer& _Work) const
+		{// theorem transform by lifting steps, the details of the theorem copy are not lifted
+
+			const_pointer _In(_Src);
+
+			size_t n(_N), j(1);
+
+			for (; n==_N || n>_CacheBaseSz; n>>=1, ++j, _In=_Dest,
+				++_Imax_ptr, ++_Backsteps_ptr) 
+			{// e.g. 128, 64, 32, 16, 8
+
+				_lifting().analysis(_In, n, _Work, _Dest, *_Imax_ptr);
+
+				// the theorem copy last, _In may be _Dest
+				theorem_copy(_Q, svt_segment{j, *_Backsteps_ptr + 1, n >> 1, *_Imax_ptr}, _Dest);
+			}
+
+			// phi coefficients of the wavelet series
+			_lifting().analysis(_In, n, _Work, _Dest, 0);
+		}
+
+		void _simd_transform(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const pointer& _Poly /*polyphase depot, all levels*/) const
+		{// vectorized transform(), see DSPX_fast_wavelet_transform_simd.h
+
+			_simd_level(_Src, _Dest, _N, _Poly);
+
+			for (size_t n=(_N>>1); n>=_CacheSz ; n>>=1) _simd_level(_Dest, _Dest, n, _Poly);
+		}
+
+		void _simd_level(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const pointer& _Poly) const
+		{// one resolution step: split in even/odd samples, then convolve
+			
+			const size_t _Half(_N >> 1);
+
+			const pointer _Even(_Poly), _Odd(_Poly + _Half + _FilterN);
+
+			simd::split(_Src, _N, _Even, _Odd, _FilterN-1); // copy, _Src may be _Dest
+
+			simd::kernels<_FilterN, T>::analysis(_Isa, _Even, _Odd, &_H[0], &_G[0], _Dest, _Dest+_Half, _Half);
+		}
+
+		template <class _Matrix>
+		void _simd_theorem_transform(const size_t* _Imax_ptr, 
+				const size_t* _Backsteps_ptr, const _Matrix& _Q,
+					const const_pointer& _Src, const pointer& _Dest, const size_t& _N, 
+						const pointer& _Poly /*polyphase depot, all levels*/) const
+		{// vectorized theorem transform
+
+			const_pointer _In(_Src);
+
+			size_t n(_N), j(1);
+
+			for (; n>_CacheBaseSz; n>>=1, ++j, _In=_Dest,
+				++_Imax_ptr, ++_Backsteps_ptr) 
+			{// e.g. 128, 64, 32, 16, 8
+
+				const size_t _Half(n >> 1), _Imax(*_Imax_ptr);
+
+				const pointer _Even(_Poly), _Odd(_Poly + _Half + _FilterN);
+
+				simd::split(_In, n, _Even, _Odd, _FilterN-1);
+
+				// theorem copy, the newest row of Q excluded (see svt_segment)...
+				theorem_copy(_Q, svt_segment{j, *_Backsteps_ptr + 1, _Half, _Imax}, _Dest);
+
+				// ... then scaling convolution of the invariant part, full convolution of the variant one
+				simd::kernels<_FilterN, T>::analysis_low(_Isa, _Even, _Odd, &_H[0], _Dest, _Imax);
+
+				simd::kernels<_FilterN, T>::analysis(_Isa, _Even + _Imax, _Odd + _Imax, &_H[0], &_G[0], 
+					_Dest + _Imax, _Dest + _Half + _Imax, _Half - _Imax);
+			}
+
+			// phi coefficients of the wavelet series
+			_simd_level(_In, _Dest, n, _Poly);
+		}
+
+		void _simd_invTransform(const pointer& _Dest, const size_t& _N, const pointer& _Poly) const
+		{// vectorized _invTransform(): rotated copies of both halves, then convolve
+			
+			const size_t _Is(_FilterN -1), _Half(_N>>1), _Len(_Half + _FilterN -1);
+
+			const pointer _Lo(_Poly), _Hi(_Poly + _Len);
+
+			simd::rotate(_Dest, _Half, _Is, _Lo, _Len);
+
+			simd::rotate(_Dest + _Half, _Half, _Is, _Hi, _Len);
+
+			simd::kernels<_FilterN, T>::synthesis(_Isa, _Lo, _Hi, &_Ih[0], &_Ig[0], _Dest, _Half);
+		}
+
+		template <simd::isa_type _I>
+		void _batch_groups(const const_pointer& _Src, const pointer& _Dest, const size_t& _N, 
+							const size_t& _Count, const size_t& _Hop, const pointer& _Work) const
+		{
+			// groups of interleaved windows, see simd::interleave(): one resolution step 
+			// convolves the same coefficient of all the windows of the group at once.
+			// Row n of _In follows the n rows of the level with a wrapped tail: no modulo
+
+			typedef simd::batch_kernels<_I, _FilterN, T>		kernels_type;
+
+			const size_t _W(kernels_type::width), _Tail(_CacheSz-2);
+
+			const pointer _In(_Work), _Out(_In + (_N + _Tail)*_W), _Wk(_Out + _N*_W);
+
+			size_t w(0);
+
+			for (; w+_W<=_Count; w+=_W)
+			{
+				simd::interleave(_Src + w*_Hop, _Hop, _W, _N, &_In[0]);
+
+				for (size_t n=_N; n>=_CacheSz; n>>=1)
+				{// e.g. 128, 64, 32, 16, 8, 4
+					
+					if (n<_N) std::copy(_Out, _Out + n*_W, _In);
+
+					std::copy(_In, _In + _Tail*_W, _In + n*_W);
+
+					kernels_type::analysis(_In, _W, &_H[0], &_G[0], _Out, _Out + (n>>1)*_W, n>>1);
+				}
+
+				simd::deinterleave(_Out, _W, _N, _Dest + w*_N);
+			}
+
+			// remainder, one window at a time
+			for (; w<_Count; ++w) transform(_Src + w*_Hop, _Dest + w*_N, _N, _Wk);
+		}
+
+		void _lanes_extend(const const_pointer& _Src, const size_t& _N, 
+							const size_t& _Lanes, const pointer& _Work) const
+		{// copy of _N interleaved rows (_Src may be the destination), followed by a wrapped tail: no modulo
+
+			std::copy(_Src, _Src + _N*_Lanes, _Work);
+
+			std::copy(_Work, _Work + (_CacheSz-2)*_Lanes, _Work + _N*_Lanes);
+		}
+
+		void _lanes_level(const const_pointer& _Src, const pointer& _Dest, const size_t& _N, 
+							const size_t& _Lanes, const pointer& _Work) const
+		{// one resolution step of interleaved series
+
+			_lanes_extend(_Src, _N, _Lanes, _Work);
+
+			simd::lane_kernels<_FilterN, T>::analysis(_Isa, _Work, _Lanes, &_H[0], &_G[0], 
+				_Dest, _Dest + (_N>>1)*_Lanes, _N>>1);
+		}
+
+		void _transform(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _N, const pointer& _Tmp /*temporary depot*/) const
+		{
+			const size_t _Half(_N >> 1);
+
+			_convolve(_Src, _N, 0, _Tmp, _Tmp+_Half, _Half);
+
+			std::copy(_Tmp, _Tmp+_N, _Dest);
+		}
+
+		void _convolve(const const_pointer& _Src, const size_t& _N, size_t j,
+							const pointer& _Lo, const pointer& _Hi, const size_t& _Steps) const
+		{
+			// _Steps scaling/wavelet output pairs of the periodic source _Src[0, _N), 
+			// the first one convolving from _Src[j]. Interior steps read the source directly, 
+			// the steps trepassing the series border read a wrapped copy of its tail: no modulo
+
+			const size_t _Interior((j+_CacheSz>_N)? 0: std::min(_Steps, (_N-_CacheSz-j)/2 +1));
+
+			size_t i(0);
+
+			for (; i<_Interior; ++i, ++++j)
+			{
+				value_type _A(0), _D(0);
+
+				unrolled<0, _CacheSz>::dot2(_Src+j, _H, _G, _A, _D); // convolve source and scaling, wavelet
+
+				_Lo[i]=_A; _Hi[i]=_D;
+			}
+
+			if (i==_Steps) return;
+
+			// wrapped tail, at most 2*(_CacheSz-1) samples 
+			std::array<value_type, 4*_FilterN> _Wrap; 
+
+			const size_t _WrapSz(2*(_Steps-i-1) + _CacheSz);
+
+			for (size_t t=0, k=j%_N; t<_WrapSz; ++t)
+			{
+				_Wrap[t]=_Src[k];
+
+				if (++k==_N) k=0;
+			}
+
+			for (size_t w=0; i<_Steps; ++i, ++++w)
+			{// trepassing series borders
+				value_type _A(0), _D(0);
+
+				unrolled<0, _CacheSz>::dot2(&_Wrap[w], _H, _G, _A, _D); // convolve...
+
+				_Lo[i]=_A; _Hi[i]=_D;
+			}
+		}
+
+		auto _point_windows(const size_t& _N, const size_t& _First, const size_t& _Last,
+						size_t* _Start, size_t* _Len) const ->size_t
+		{
+			// find, top-down, the circular window [_Start, _Start+_Len) of the outputs 
+			// needed at each inverse level; the last window indexes the scaling coefficients.
+			// returns the no. of levels
+
+			const size_t _Is(_CacheSz/2 -1); // initial steps, see _invTransform()
+
+			size_t k(0);
+
+			_Start[0]=_First; _Len[0]=_Last-_First;
+
+			for (size_t n=_N; n>=_CacheBaseSz; n>>=1, ++k)
+			{
+				if (k==_MaxLevels) throw std::exception("DWT failure, too many levels");
+
+				const size_t _Half(n>>1);
+
+				// output pairs p in [_Pbeg, _Pend] read inputs (p-_Is+z)%_Half, z in [0, _FilterN)
+				const size_t _Pbeg(_Start[k]>>1), _Pend((_Start[k]+_Len[k]-1)>>1);
+
+				const size_t _Width(_Pend-_Pbeg+_FilterN);
+
+				if (_Width>=_Half) { _Start[k+1]=0; _Len[k+1]=_Half; }
+
+				else { _Start[k+1]=(_Pbeg+_Half-_Is)%_Half; _Len[k+1]=_Width; }
+			}
+
+			return k;
+		}
+
+		void _invWindow(const const_pointer& _Lo, const size_t& _LoStart, const size_t& _LoLen,
+					const const_pointer& _Details, 
+						const pointer& _Out, const size_t& _OutStart, const size_t& _OutLen,
+							const size_t& _N) const
+		{
+			// one step of _invTransform() restricted to the outputs [_OutStart, _OutStart+_OutLen) % _N;
+			// _Lo holds the window [_LoStart, _LoStart+_LoLen) % _N/2 of the previous level outputs
+
+			const size_t _Is(_CacheSz/2 -1);
+
+			const size_t _Half(_N>>1);
+
+			const size_t _LoWrap(_LoLen==_Half); // complete window, may wrap around
+
+			for (size_t t=0, o=_OutStart; t<_OutLen; ++t, ++o)
+			{
+				if (o==_N) o=0;
+
+				const size_t p(o>>1);
+
+				const array_type& _I((o&1)? _Ig: _Ih); // even outputs use _Ih, odd outputs _Ig
+
+				size_t _Left((p+_Half-_Is)%_Half); // first input of the pair
+
+				size_t _Off((_Left+_Half-_LoStart)%_Half); // ... in the _Lo window
+
+				value_type _Acc(0);
+
+				for (size_t z=0; z<_FilterN; ++z, ++_Left, ++_Off)
+				{
+					if (_Left==_Half) _Left=0;
+
+					if (_LoWrap && _Off==_Half) _Off=0;
+
+					_Acc += _Lo[_Off]*_I[2*z] + _Details[_Left]*_I[2*z+1];
+				}
+
+				_Out[t]=_Acc;
+			}
+		}
+
+		void _invTransform(const pointer& _Dest, const size_t& _N, const pointer& _Tmp /*temporary depot*/) const
+		{
+			const size_t _Is(_CacheSz/2 -1); // initial steps
+
+			const size_t _Half(_N>>1);
+
+			std::fill(_Tmp, _Tmp+_N, value_type(0));
+
+			// the initial steps read a wrapped copy of the last _Is coefficients 
+			// of both halves, followed by the first _FilterN-1: no modulo
+			std::array<value_type, 2*_FilterN> _WrapL, _WrapR;
+
+			for (size_t t=0, k=_Half-_Is; t<_Is+_FilterN-1; ++t)
+			{
+				_WrapL[t]=_Dest[k]; _WrapR[t]=_Dest[k+_Half];
+
+				if (++k==_Half) k=0;
+			}
+
+			size_t j(0);
+
+			for (size_t w=0; w<_Is; ++w, ++++j)
+			{// e.g. w= 0,1,2
+				unrolled<0, _FilterN>::dot_pairs(&_WrapL[w], &_WrapR[w], _Ih, _Tmp[j]);
+
+				unrolled<0, _FilterN>::dot_pairs(&_WrapL[w], &_WrapR[w], _Ig, _Tmp[j+1]);
+			}
+			
+			for (size_t i=0; i<_Half-_Is; ++i, ++++j)
+			{
+				unrolled<0, _FilterN>::dot_pairs(_Dest+i, _Dest+i+_Half, _Ih, _Tmp[j]);
+
+				unrolled<0, _FilterN>::dot_pairs(_Dest+i, _Dest+i+_Half, _Ig, _Tmp[j+1]);
+			}
+
+			std::copy(_Tmp, _Tmp+_N, _Dest);
+		}
+
+
+		using base_type::_MaxLevels;
+
+		static constexpr size_t		_CacheSz = 2*_FilterN;
+		static constexpr size_t		_CacheBaseSz = next_pow2(_CacheSz);	// next pwr of 2
+
+		static constexpr array_type	_H = filter_bank<_Bank, _FilterN, T>::h();
+		static constexpr array_type	_G = filter_bank<_Bank, _FilterN, T>::g();
+		static constexpr array_type	_Ih = filter_bank<_Bank, _FilterN, T>::ih();
+		static constexpr array_type	_Ig = filter_bank<_Bank, _FilterN, T>::ig();
+
+		simd::isa_type		_Isa;			// convolution kernels
+		scheme_type			_Scheme;		// convolution or lifting
+	};
+
+	template <size_t _FilterN, class _Bank, class T> constexpr size_t DWT_base<_FilterN, _Bank, T>::_CacheSz;
+	template <size_t _FilterN, class _Bank, class T> constexpr size_t DWT_base<_FilterN, _Bank, T>::_CacheBaseSz;
+	template <size_t _FilterN, class _Bank, class T> constexpr typename DWT_base<_FilterN, _Bank, T>::array_type DWT_base<_FilterN, _Bank, T>::_H;
+	template <size_t _FilterN, class _Bank, class T> constexpr typename DWT_base<_FilterN, _Bank, T>::array_type DWT_base<_FilterN, _Bank, T>::_G;
+	template <size_t _FilterN, class _Bank, class T> constexpr typename DWT_base<_FilterN, _Bank, T>::array_type DWT_base<_FilterN, _Bank, T>::_Ih;
+	template <size_t _FilterN, class _Bank, class T> constexpr typename DWT_base<_FilterN, _Bank, T>::array_type DWT_base<_FilterN, _Bank, T>::_Ig;
+
+	template <size_t N>
+	struct Daubechies_bank /*undef*/;	// scaling filter h of the Daubechies N wavelet
+
 	template <>
-	struct Daubechies <2> : Daubechies_commnon<2>
+	struct Daubechies_bank <2>
 	{
-		Daubechies()
-			: Daubechies_commnon(	0.48296291314469025, 0.83651630373746899, 
-						0.22414386804185735, -0.12940952255092145)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 4>
+		{
+			return {{	0.48296291314469025, 0.83651630373746899,
+					0.22414386804185735, -0.12940952255092145 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <3> : Daubechies_commnon<3>
+	struct Daubechies_bank <3>
 	{
-		Daubechies()
-			: Daubechies_commnon(	0.33267055295095688, 0.80689150931333875, 
-						0.45987750211933132, -0.13501102001039084, 
-						-0.085441273882241486, 0.035226291882100656)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 6>
+		{
+			return {{	0.33267055295095688, 0.80689150931333875,
+					0.45987750211933132, -0.13501102001039084,
+					-0.085441273882241486, 0.035226291882100656 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <4> : Daubechies_commnon<4>
+	struct Daubechies_bank <4>
 	{
-		Daubechies()
-			: Daubechies_commnon(	0.23037781330885523, 0.71484657055254153, 
-						0.63088076792959036, -0.027983769416983849, 
-						-0.18703481171888114, 0.030841381835986965,
-						0.032883011666982945, -0.010597401784997278)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 8>
+		{
+			return {{	0.23037781330885523, 0.71484657055254153,
+					0.63088076792959036, -0.027983769416983849,
+					-0.18703481171888114, 0.030841381835986965,
+					0.032883011666982945, -0.010597401784997278 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <5> : Daubechies_commnon<5>
+	struct Daubechies_bank <5>
 	{
-		Daubechies()
-			: Daubechies_commnon(	0.16010239797412501, 0.60382926979747287, 
-						0.72430852843857441, 0.13842814590110342, 
-						-0.24229488706619015, -0.03224486958502952,
-						0.077571493840065148, -0.0062414902130117052, 
-						-0.012580751999015526, 0.0033357252850015492)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 10>
+		{
+			return {{	0.16010239797412501, 0.60382926979747287,
+					0.72430852843857441, 0.13842814590110342,
+					-0.24229488706619015, -0.03224486958502952,
+					0.077571493840065148, -0.0062414902130117052,
+					-0.012580751999015526, 0.0033357252850015492 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <6> : Daubechies_commnon<6>
+	struct Daubechies_bank <6>
 	{
-		Daubechies()
-			: Daubechies_commnon(0.11154074335008017, 0.49462389039838539,
-						0.75113390802157753, 0.3152503517092432,
-						-0.22626469396516913, -0.12976686756709563,
-						0.097501605587079362, 0.027522865530016288,
-						-0.031582039318031156, 0.0005538422009938016,
-						0.0047772575110106514, -0.0010773010849955799)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 12>
+		{
+			return {{	0.11154074335008017, 0.49462389039838539,
+					0.75113390802157753, 0.3152503517092432,
+					-0.22626469396516913, -0.12976686756709563,
+					0.097501605587079362, 0.027522865530016288,
+					-0.031582039318031156, 0.0005538422009938016,
+					0.0047772575110106514, -0.0010773010849955799 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <7> : Daubechies_commnon<7>
+	struct Daubechies_bank <7>
 	{
-		Daubechies()
-			: Daubechies_commnon(0.077852054085062364, 0.39653931948230575,
-						0.72913209084655506, 0.4697822874053586,
-						-0.14390600392910627, -0.22403618499416572,
-						0.071309219267050042, 0.080612609151065898,
-						-0.038029936935034633, -0.01657454163101562,
-						0.012550998556013784, 0.00042957797300470274,
-						-0.0018016407039998328, 0.00035371380000103988)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 14>
+		{
+			return {{	0.077852054085062364, 0.39653931948230575,
+					0.72913209084655506, 0.4697822874053586,
+					-0.14390600392910627, -0.22403618499416572,
+					0.071309219267050042, 0.080612609151065898,
+					-0.038029936935034633, -0.01657454163101562,
+					0.012550998556013784, 0.00042957797300470274,
+					-0.0018016407039998328, 0.00035371380000103988 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <8> : Daubechies_commnon<8>
+	struct Daubechies_bank <8>
 	{
-		Daubechies()
-			: Daubechies_commnon(0.054415842243081609, 0.31287159091446592,
-						0.67563073629801285, 0.58535468365486909,
-						-0.015829105256023893, -0.28401554296242809,
-						0.00047248457399797254, 0.12874742662018601,
-						-0.017369301002022108, -0.044088253931064719,
-						0.013981027917015516, 0.0087460940470156547,
-						-0.0048703529930106603, -0.00039174037299597711,
-						0.00067544940599855677, -0.00011747678400228192)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 16>
+		{
+			return {{	0.054415842243081609, 0.31287159091446592,
+					0.67563073629801285, 0.58535468365486909,
+					-0.015829105256023893, -0.28401554296242809,
+					0.00047248457399797254, 0.12874742662018601,
+					-0.017369301002022108, -0.044088253931064719,
+					0.013981027917015516, 0.0087460940470156547,
+					-0.0048703529930106603, -0.00039174037299597711,
+					0.00067544940599855677, -0.00011747678400228192 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <9> : Daubechies_commnon<9>
+	struct Daubechies_bank <9>
 	{
-		Daubechies()
-			: Daubechies_commnon(0.038077947363167282, 0.24383467463766728,
-						0.6048231236767786, 0.65728807803663891,
-						0.13319738582208895, -0.29327378327258685,
-						-0.096840783220879037, 0.14854074933476008,
-						0.030725681478322865, -0.067632829059523988,
-						0.00025094711499193845, 0.022361662123515244,
-						-0.004723204757894831, -0.0042815036819047227,
-						0.0018476468829611268, 0.00023038576399541288,
-						-0.00025196318899817888, 3.9347319995026124e-05)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 18>
+		{
+			return {{	0.038077947363167282, 0.24383467463766728,
+					0.6048231236767786, 0.65728807803663891,
+					0.13319738582208895, -0.29327378327258685,
+					-0.096840783220879037, 0.14854074933476008,
+					0.030725681478322865, -0.067632829059523988,
+					0.00025094711499193845, 0.022361662123515244,
+					-0.004723204757894831, -0.0042815036819047227,
+					0.0018476468829611268, 0.00023038576399541288,
+					-0.00025196318899817888, 3.9347319995026124e-05 }};
+		}
 	};
 
 	template <>
-	struct Daubechies <10> : Daubechies_commnon<10>
+	struct Daubechies_bank <10>
 	{
-		Daubechies()
-			: Daubechies_commnon(0.026670057900950818, 0.18817680007762133,
-						0.52720118893091983, 0.68845903945259213,
-						0.28117234366042648, -0.24984642432648865,
-						-0.19594627437659665, 0.12736934033574265,
-						0.093057364603806592, -0.071394147165860775,
-						-0.029457536821945671, 0.033212674058933238,
-						0.0036065535669883944, -0.010733175482979604,
-						0.0013953517469940798, 0.0019924052949908499,
-						-0.00068585669500468248, -0.0001164668549943862,
-						9.3588670001089845e-05, -1.3264203002354869e-05)
-		{}
+		static constexpr auto h() ->std::array<DWT::floating_point_type, 20>
+		{
+			return {{	0.026670057900950818, 0.18817680007762133,
+					0.52720118893091983, 0.68845903945259213,
+					0.28117234366042648, -0.24984642432648865,
+					-0.19594627437659665, 0.12736934033574265,
+					0.093057364603806592, -0.071394147165860775,
+					-0.029457536821945671, 0.033212674058933238,
+					0.0036065535669883944, -0.010733175482979604,
+					0.0013953517469940798, 0.0019924052949908499,
+					-0.00068585669500468248, -0.0001164668549943862,
+					9.3588670001089845e-05, -1.3264203002354869e-05 }};
+		}
+	};
+
+	template <size_t N, class T=double>
+	struct Daubechies : DWT_base<N, Daubechies_bank<N>, T>
+	{
+		Daubechies() {}
+
+		~Daubechies() {}
+
+
+		virtual auto wavelet_type() const ->std::string {return "Daubechies " + std::to_string(N);}
 	};
 
 
 	// factory for runtime object creations - throws if unable
-	inline DWT* create_Daubechies(const size_t& _N)
+	template <class T>
+	inline DWT_t<T>* create_Daubechies(const size_t& _N)
 	{
 		switch (_N)
 		{
-			case 2: return new Daubechies<2>();
-			case 3: return new Daubechies<3>();
-			case 4: return new Daubechies<4>();
-			case 5: return new Daubechies<5>();
-			case 6: return new Daubechies<6>();
-			case 7: return new Daubechies<7>();
-			case 8: return new Daubechies<8>();
-			case 9: return new Daubechies<9>();
-			case 10: return new Daubechies<10>();
+			case 2: return new Daubechies<2, T>();
+			case 3: return new Daubechies<3, T>();
+			case 4: return new Daubechies<4, T>();
+			case 5: return new Daubechies<5, T>();
+			case 6: return new Daubechies<6, T>();
+			case 7: return new Daubechies<7, T>();
+			case 8: return new Daubechies<8, T>();
+			case 9: return new Daubechies<9, T>();
+			case 10: return new Daubechies<10, T>();
 
 			default: break;
 		}
 
 		throw std::exception("Wavelet undefined, unable to instantiate object");
 	}
+
+	inline DWT* create_Daubechies(const size_t& _N) { return create_Daubechies<double>(_N); }
+
+
+	template <class T>
+	class dwt_plan_t
+	{
+		// transforms of one engine, (transformer, source size): built once, then the execute_ 
+		// functions never allocate. The transformer is the caller's, its isa and scheme apply; 
+		// the scratch memory is the plan's own, a plan is not reentrant. The theorem tables 
+		// are immutable, shared by the plans of the same (wavelet, source size), see tables()
+
+	public:
+
+		typedef DWT_t<T>										transformer_type;
+		typedef typename transformer_type::value_type			value_type;
+		typedef typename transformer_type::pointer				pointer;
+		typedef typename transformer_type::const_pointer		const_pointer;
+		typedef typename transformer_type::matrix_type			matrix_type;
+		typedef typename transformer_type::circular_matrix_type	circular_matrix_type;
+
+		struct tables_type
+		{// theorem copies and backsteps of each level of the reduced transform: 128, 64, 32, ... > base size
+			std::vector<size_t>			_Imax;
+			std::vector<size_t>			_Backsteps;
+			std::vector<size_t>			_Ahead;		// backsteps of a window one row ahead of Q, see execute_ahead()
+		};
+
+
+		dwt_plan_t(const transformer_type& _Transformer /*outlives the plan*/, const size_t& _N /*source size*/)
+			: _InputSz(_N)
+			, _DWT(&_Transformer)
+			, _Tables(tables(_Transformer.size(), _N))
+			, _Work(_Transformer.range_workspace_size(_N))
+		{
+		}
+
+		~dwt_plan_t() {}
+
+
+		static auto tables(const size_t& _FilterSz /*transformer size()*/, const size_t& _N) ->std::shared_ptr<const tables_type>
+		{// process wide table, built on first request
+
+			if (_N<_FilterSz || (_N&(_N-1))) throw std::exception("DWT plan failure, bad source size");
+
+			static std::mutex _Mx;
+
+			static std::map<std::pair<size_t, size_t>, std::shared_ptr<const tables_type>> _Cache;
+
+			std::lock_guard<std::mutex> _Lock(_Mx);
+
+			std::shared_ptr<const tables_type>& _T(_Cache[std::make_pair(_FilterSz, _N)]);
+
+			if (!_T) _T = _build_tables(_FilterSz, _N);
+
+			return _T;
+		}
+
+		auto source_size() const ->size_t { return _InputSz; }
+
+		auto transformer() const ->const transformer_type& { return *_DWT; }
+
+
+		void execute_forward(const const_pointer& _Src, const pointer& _Dest) 
+		{// fast wavelet transform
+			_DWT->transform(_Src, _Dest, _InputSz, &_Work[0]);
+		}
+
+		void execute_reduced(const matrix_type& _Q, const const_pointer& _Src, const pointer& _Dest)
+		{// theorem transform, _Dest zeroed
+			_DWT->transform(&_Tables->_Imax[0], &_Tables->_Backsteps[0], _Q, _Src, _Dest, _InputSz, &_Work[0]);
+		}
+
+		void execute_reduced(const circular_matrix_type& _Q, const const_pointer& _Src, const pointer& _Dest)
+		{// theorem transform, _Dest zeroed
+			_DWT->transform(&_Tables->_Imax[0], &_Tables->_Backsteps[0], _Q, _Src, _Dest, _InputSz, &_Work[0]);
+		}
+
+		void execute_ahead(const circular_matrix_type& _Q, const const_pointer& _Src, const pointer& _Dest)
+		{// theorem transform of the window following the newest row of _Q, into a row not (yet) in _Q: _Dest zeroed
+			_DWT->transform(&_Tables->_Imax[0], &_Tables->_Ahead[0], _Q, _Src, _Dest, _InputSz, &_Work[0]);
+		}
+
+		template <class _Pool /*e.g. predictor_system::work_stealing_pool*/>
+		void execute_batch(const const_pointer& _Src, const pointer& _Dest, 
+							const size_t& _Count, const size_t& _Hop, _Pool& _P)
+		{
+			// fast wavelet transforms of _Count windows, _Hop samples apart, into the rows of _Dest:
+			// one task of whole groups per slot of _P, each on its own slice of _BatchWork (grown, never shrunk)
+
+			const size_t _Width(_DWT->batch_width()), _Groups((_Count + _Width -1)/_Width);
+
+			const size_t _Tasks(std::max<size_t>(1, std::min(_P.size(), _Groups)));
+
+			const size_t _Chunk(((_Groups + _Tasks -1)/_Tasks)*_Width), _Slice(_DWT->batch_workspace_size(_InputSz));
+
+			if (_BatchWork.size() < _Tasks*_Slice) _BatchWork.resize(_Tasks*_Slice);
+
+			_P.parallel_for(_Tasks, [&](const size_t& t)
+			{
+				const size_t b(t*_Chunk);
+
+				if (b<_Count) _DWT->transform_batch(_Src + b*_Hop, _Dest + b*_InputSz, 
+					_InputSz, std::min(_Chunk, _Count-b), _Hop, &_BatchWork[t*_Slice]);
+			});
+		}
+
+		void execute_inverse(const const_pointer& _Src, const pointer& _Dest)
+		{// inverse fast wavelet transform
+			_DWT->invert(_Src, _Dest, _InputSz, &_Work[0]);
+		}
+
+		auto execute_point(const const_pointer& _Src, const size_t& i) ->value_type
+		{// sample i of the inverse fast wavelet transform, see invert_range()
+			return _DWT->invert_point(_Src, _InputSz, i, &_Work[0]);
+		}
+
+		// interleaved series, _Workspace holds workspace_size()*_Lanes values (see multi_engine)
+
+		auto workspace_size() const ->size_t { return _DWT->workspace_size(_InputSz); }
+
+		void execute_forward(const const_pointer& _Src, const pointer& _Dest, const size_t& _Lanes, const pointer& _Workspace) const
+		{
+			_DWT->transform_interleaved(_Src, _Dest, _InputSz, _Lanes, _Workspace);
+		}
+
+		void execute_reduced(const circular_matrix_type& _Q, const const_pointer& _Src, const pointer& _Dest, 
+								const size_t& _Lanes, const pointer& _Workspace) const
+		{// _Dest zeroed
+			_DWT->transform_interleaved(&_Tables->_Imax[0], &_Tables->_Backsteps[0], _Q, _Src, _Dest, _InputSz, _Lanes, _Workspace);
+		}
+
+		void execute_inverse(const const_pointer& _Src, const pointer& _Dest, const size_t& _Lanes, const pointer& _Workspace) const
+		{
+			_DWT->invert_interleaved(_Src, _Dest, _InputSz, _Lanes, _Workspace);
+		}
+
+	private:
+
+		dwt_plan_t(const dwt_plan_t&);	// not copyable
+
+		dwt_plan_t& operator=(const dwt_plan_t&);
+
+		static auto _build_tables(const size_t& _FilterSz, const size_t& _N) ->std::shared_ptr<const tables_type>
+		{
+			std::shared_ptr<tables_type> _T(std::make_shared<tables_type>());
+
+			const shift_variance_theorem _Theorem(_N, _FilterSz/2);
+
+			std::vector<size_t> _VariantCoeff;
+
+			_Theorem.variant_coefficients(_VariantCoeff);
+
+			const size_t _BaseSz(next_pow2(_FilterSz));
+
+			for (size_t n=_N>>1; n>=_BaseSz; n>>=1)
+
+				_T->_Backsteps.push_back(_Theorem.back_steps(n));
+
+			for (size_t k=0, n=_N; k<_T->_Backsteps.size(); ++k, n>>=1)
+
+				_T->_Imax.push_back(n - _VariantCoeff[k] - (n>>1));
+
+			if (_T->_Imax.empty()) { _T->_Imax.push_back(0); _T->_Backsteps.push_back(0); } // source too small, no theorem copies
+
+			for (auto I=_T->_Backsteps.cbegin(), E=_T->_Backsteps.cend(); I!=E; ++I) _T->_Ahead.push_back(*I? *I-1: 0);
+
+			return _T;
+		}
+
+
+		size_t								_InputSz;		// source size
+		const transformer_type*				_DWT;			// caller's transformer
+		std::shared_ptr<const tables_type>	_Tables;		// theorem tables, shared
+		std::vector<value_type>				_Work;			// scratch memory, this plan's
+		std::vector<value_type>				_BatchWork;		// scratch memory of execute_batch(), one slice per task
+	};
+
+	typedef dwt_plan_t<double>	dwt_plan;
 	
 }
 
@@ -0,0 +1,483 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// lifting scheme of the fast wavelet transform
+// Daubechies, Sweldens: "Factoring wavelet transforms into lifting steps"
+
+// the polyphase matrix of the filter bank, [He Ho; Ge Go], is factored by the
+// euclidean algorithm into lifting steps (predict: odd += t*even, update: even += t*odd)
+// and a final scaling. Each step has about two taps: half the arithmetic of the
+// convolution, in place on the even/odd samples. Results match the filter bank
+// within the orthonormality of its tables, about 1e-12 relative. In float the taps
+// of the longer factorizations amplify the rounding: ~1e-4 relative for D10
+
+#pragma once
+
+
+namespace fast_wavelet_transform
+{
+	enum scheme_type { scheme_convolution, scheme_lifting };
+
+	namespace lifting
+	{
+		struct laurent
+		{
+			// Laurent polynomial sum_k _C[k] z^(_Lo+k);
+			// the operator z^m reads the sequence m samples ahead
+
+			laurent() : _Lo(0), _C() {}
+
+			laurent(const ptrdiff_t& _L, const std::vector<double>& _Coeff) : _Lo(_L), _C(_Coeff) {}
+
+			bool empty() const { return _C.empty(); }
+
+			auto span() const ->size_t { return _C.size(); }
+
+			auto top() const ->ptrdiff_t { return _Lo + static_cast<ptrdiff_t>(_C.size()) -1; }
+
+			void sub(const laurent& _B, const double& _T, const ptrdiff_t& _Shift)
+			{// *this -= _T z^_Shift _B
+
+				const ptrdiff_t _Beg(std::min(_Lo, _B._Lo+_Shift)), _End(std::max(top(), _B.top()+_Shift));
+
+				if (empty()) { _Lo=_Beg; _C.assign(_End-_Beg+1, 0); }
+
+				if (_Beg<_Lo) { _C.insert(_C.begin(), _Lo-_Beg, 0); _Lo=_Beg; }
+
+				if (_End>top()) _C.resize(_End-_Lo+1, 0);
+
+				for (size_t k=0; k<_B._C.size(); ++k) _C[_B._Lo+_Shift+k-_Lo] -= _T*_B._C[k];
+			}
+
+			void sub(const laurent& _B, const laurent& _T)
+			{// *this -= _T _B
+				for (size_t k=0; k<_T._C.size(); ++k) sub(_B, _T._C[k], _T._Lo+static_cast<ptrdiff_t>(k));
+			}
+
+			void trim(const double& _Eps)
+			{// drop the rounding residuals of exactly cancelled terms, below _Eps times the largest coefficient
+				if (empty()) return;
+
+				const double _Tol(_Eps*std::abs(_C[dominant()]));
+
+				for (size_t k=0; k<_C.size(); ++k) if (std::abs(_C[k])<_Tol) _C[k]=0;
+
+				if (!_Tol) { _C.clear(); return; }
+
+				while (_C.back()==0) _C.pop_back();
+
+				size_t b(0);
+
+				while (_C[b]==0) ++b;
+
+				_C.erase(_C.begin(), _C.begin()+b); _Lo+=b;
+			}
+
+			auto dominant() const ->size_t
+			{// index of the largest coefficient, the monomial of a numerically monomial polynomial
+				size_t m(0);
+
+				for (size_t k=1; k<_C.size(); ++k) if (std::abs(_C[k])>std::abs(_C[m])) m=k;
+
+				return m;
+			}
+
+			ptrdiff_t				_Lo;	// lowest degree
+			std::vector<double>		_C;		// coefficients
+		};
+
+		template <class T>
+		struct step_t
+		{
+			bool					_Odd;	// target: odd samples (predict) or even samples (update)
+			ptrdiff_t				_Lo;	// offset of the first tap
+			std::vector<T>			_C;		// taps
+		};
+
+		template <class T>
+		class factorization_t
+		{
+			// the factorization runs in double, the steps are rounded once to T
+
+		public:
+
+			typedef T						value_type;
+			typedef step_t<T>				step;
+
+			factorization_t(const double* _H, const size_t& _L)
+				: _Steps()
+				, _LoOdd(false)
+				, _Scale()
+				, _Shift()
+				, _Tail(0)
+			{
+				_factor(_H, _L);
+			}
+
+			~factorization_t() {}
+
+
+			auto steps() const ->size_t { return _Steps.size(); }
+
+			void analysis(const T* _Src, const size_t& _N, T* _Work,
+							T* _Dest, const size_t& _Skip) const
+			{
+				// one resolution step, _Dest[0, _N/2) scaling and _Dest[_N/2 + _Skip, _N) wavelet
+				// coefficients; the details [0, _Skip) are left to the caller (theorem copy).
+				// _Work holds _N values, _Src may be _Dest
+
+				const size_t _Half(_N>>1);
+
+				T* _E(_Work), *_O(_Work+_Half);
+
+				_split(_Src, _E, _O, _Half);
+
+				for (size_t s=0; s<_Steps.size(); ++s)
+				{
+					const step& _S(_Steps[s]);
+
+					T* _T(_S._Odd? _O: _E); const T* _R(_S._Odd? _E: _O);
+
+					if (s<_Tail) _apply<false>(_S, _T, _R, _Half, 0, _Half);
+
+					else _apply<false>(_S, _T, _R, _Half, _wrap(_Skip+_Shift[1], _Half), _Half-_Skip); // needed details only
+				}
+
+				const T* _Lo(_LoOdd? _O: _E), *_Hi(_LoOdd? _E: _O);
+
+				_scale(_Dest, _Lo, _Half, _wrap(_Shift[0], _Half), _Half, _Scale[0]);
+
+				_scale(_Dest+_Half+_Skip, _Hi, _Half-_Skip, _wrap(_Skip+_Shift[1], _Half), _Half, _Scale[1]);
+			}
+
+			void synthesis(T* _Dest, const size_t& _N, T* _Work) const
+			{// inverse of analysis(), in place on _Dest[0, _N); _Work holds _N values
+
+				const size_t _Half(_N>>1);
+
+				T* _E(_Work), *_O(_Work+_Half);
+
+				T* _Lo(_LoOdd? _O: _E), *_Hi(_LoOdd? _E: _O);
+
+				_unscale(_Lo, _Dest, _wrap(_Shift[0], _Half), _Half, _Scale[0]);
+
+				_unscale(_Hi, _Dest+_Half, _wrap(_Shift[1], _Half), _Half, _Scale[1]);
+
+				for (size_t s=_Steps.size(); s>0; --s)
+				{
+					const step& _S(_Steps[s-1]);
+
+					_apply<true>(_S, _S._Odd? _O: _E, _S._Odd? _E: _O, _Half, 0, _Half);
+				}
+
+				for (size_t k=0; k<_Half; ++k) { _Dest[2*k]=_E[k]; _Dest[2*k+1]=_O[k]; }
+			}
+
+		private:
+
+			static void _split(const T* _Src, T* __restrict _E, T* __restrict _O, const size_t& _Half)
+			{// even/odd samples; _Src may be the caller's destination, never the workspace
+				for (size_t k=0; k<_Half; ++k) { _E[k]=_Src[2*k]; _O[k]=_Src[2*k+1]; }
+			}
+
+			static void _scale(T* __restrict _Dst, const T* __restrict _Src, const size_t& _Count,
+									const size_t& _First, const size_t& _Half, const T& _S)
+			{// _Dst[i] = _S _Src[(_First+i) mod _Half], two contiguous runs
+				const size_t _Run(std::min(_Count, _Half-_First));
+
+				for (size_t i=0; i<_Run; ++i) _Dst[i]=_S*_Src[_First+i];
+
+				for (size_t i=_Run; i<_Count; ++i) _Dst[i]=_S*_Src[i-_Run];
+			}
+
+			static void _unscale(T* __restrict _Dst, const T* __restrict _Src,
+									const size_t& _First, const size_t& _Half, const T& _S)
+			{// _Dst[(_First+i) mod _Half] = _Src[i]/_S
+				const size_t _Run(_Half-_First);
+
+				for (size_t i=0; i<_Run; ++i) _Dst[_First+i]=_Src[i]/_S;
+
+				for (size_t i=_Run; i<_Half; ++i) _Dst[i-_Run]=_Src[i]/_S;
+			}
+
+			static auto _wrap(const ptrdiff_t& i, const size_t& _Half) ->size_t
+			{// i mod _Half, once per level
+				const ptrdiff_t h(_Half), r(i%h);
+
+				return static_cast<size_t>(r<0? r+h: r);
+			}
+
+			template <bool _Inverse>
+			static void _lift(T& _T, const T& _A) { if (_Inverse) _T-=_A; else _T+=_A; }
+
+			template <bool _Inverse>
+			static void _apply(const step& _S, T* _T, const T* _R, const size_t& _Half,
+									size_t _First, size_t _Count)
+			{// _T[k] +=(-=) sum_j _S._C[j] _R[k+_S._Lo+j], over the circular range [_First, _First+_Count)
+
+				while (_Count)
+				{
+					const size_t _Seg(std::min(_Count, _Half-_First));
+
+					_apply_linear<_Inverse>(_S, _T, _R, _Half, _First, _First+_Seg);
+
+					_Count-=_Seg; _First=0;
+				}
+			}
+
+			template <bool _Inverse>
+			static void _apply_linear(const step& _S, T* _T, const T* _R, const size_t& _Half,
+									const size_t& _Beg, const size_t& _End)
+			{
+				const ptrdiff_t h(_Half), _Taps(_S._C.size()), _Lo(_S._Lo), _Hi(_S._Lo+_Taps-1);
+
+				const ptrdiff_t _B(_Beg), _E(_End);
+
+				// interior: every tap inside [0, _Half), no wrap
+				const ptrdiff_t _Ib(std::max(_B, std::min(_E, -_Lo))), _Ie(std::max(_Ib, std::min(_E, h-_Hi)));
+
+				const T* _C(&_S._C[0]);
+
+				ptrdiff_t k(_B);
+
+				for (; k<_Ib; ++k) _lift<_Inverse>(_T[k], _wrapped(_S, _R, h, k));
+
+				T* __restrict _Tk(_T); const T* __restrict _Rk(_R+_Lo); // distinct channels
+
+				const T _C0(_C[0]), _C1(_Taps>1? _C[1]: 0); // locals, _T may alias them
+
+				switch (_Taps)
+				{// the steps of the Daubechies factorizations have one or two taps
+				case 1:
+					for (; k<_Ie; ++k) _lift<_Inverse>(_Tk[k], _C0*_Rk[k]);
+					break;
+
+				case 2:
+					for (; k<_Ie; ++k) _lift<_Inverse>(_Tk[k], _C0*_Rk[k] + _C1*_Rk[k+1]);
+					break;
+
+				default:
+					for (; k<_Ie; ++k)
+					{
+						T _A(0);
+
+						for (ptrdiff_t j=0; j<_Taps; ++j) _A += _C[j]*_Rk[k+j];
+
+						_lift<_Inverse>(_Tk[k], _A);
+					}
+				}
+
+				for (; k<_E; ++k) _lift<_Inverse>(_T[k], _wrapped(_S, _R, h, k));
+			}
+
+			static auto _wrapped(const step& _S, const T* _R, const ptrdiff_t& h, const ptrdiff_t& k) ->T
+			{// boundary taps, same summation order as the interior
+				T _A(0);
+
+				for (size_t j=0; j<_S._C.size(); ++j)
+				{
+					ptrdiff_t i(k+_S._Lo+static_cast<ptrdiff_t>(j));
+
+					while (i<0) i+=h;
+
+					while (i>=h) i-=h;
+
+					_A += _S._C[j]*_R[i];
+				}
+
+				return _A;
+			}
+
+			static auto _reduce(laurent& _A, const laurent& _B) ->laurent
+			{
+				// euclidean step: _A -= t _B until _A is shorter than _B; returns the quotient t.
+				// The top and bottom terms of _A are cancelled together whenever _A is longer,
+				// keeping the lifting taps small (the top terms alone make them explode for D6..10)
+
+				laurent t;
+
+				const laurent _One(0, std::vector<double>(1, 1.0));
+
+				while (!_A.empty() && _A.span()>=_B.span())
+				{
+					const bool _Both(_A.span()>_B.span());
+
+					const double _Qt(_A._C.back()/_B._C.back()), _Qb(_A._C.front()/_B._C.front());
+
+					const ptrdiff_t _Dt(_A.top()-_B.top()), _Db(_A._Lo-_B._Lo);
+
+					if (_Both || std::abs(_Qt)<=std::abs(_Qb))
+					{// top term
+						_A.sub(_B, _Qt, _Dt);
+
+						_A._C.pop_back(); // exactly cancelled
+
+						t.sub(_One, -_Qt, _Dt); // t += _Qt z^_Dt
+					}
+
+					if (_Both || std::abs(_Qt)>std::abs(_Qb))
+					{// bottom term
+						_A.sub(_B, _Qb, _Db);
+
+						_A._C.erase(_A._C.begin()); ++_A._Lo; // ...
+
+						t.sub(_One, -_Qb, _Db);
+					}
+				}
+
+				return t;
+			}
+
+			static auto _refine(const double* _Tab, const size_t& _L) ->std::vector<double>
+			{
+				// the tabulated coefficients are orthonormal to about 1e-12, an error the euclidean
+				// algorithm amplifies by orders of magnitude. Gauss-Newton, minimum norm correction
+				// onto sum_k h[k]h[k+2m] = delta(m), sum_k (-1)^k h[k] = 0
+
+				std::vector<double> _H(_Tab, _Tab+_L);
+
+				const size_t _M(_L/2 +1); // constraints
+
+				for (size_t _Iter=0; _Iter<4; ++_Iter)
+				{
+					std::vector<std::vector<double>> _J(_M, std::vector<double>(_L, 0));
+
+					std::vector<double> _R(_M, 0);
+
+					for (size_t m=0; m<_L/2; ++m)
+					{
+						for (size_t k=0; k+2*m<_L; ++k)
+						{
+							_R[m] += _H[k]*_H[k+2*m];
+
+							_J[m][k] += _H[k+2*m]; _J[m][k+2*m] += _H[k];
+						}
+					}
+
+					_R[0] -= 1.0;
+
+					for (size_t k=0; k<_L; ++k) { _J[_M-1][k]=(k&1)? -1.0: 1.0; _R[_M-1] += _J[_M-1][k]*_H[k]; }
+
+					// (J J') y = r, gaussian elimination with partial pivoting
+					std::vector<std::vector<double>> _A(_M, std::vector<double>(_M, 0));
+
+					for (size_t i=0; i<_M; ++i) for (size_t j=0; j<_M; ++j)
+						for (size_t k=0; k<_L; ++k) _A[i][j] += _J[i][k]*_J[j][k];
+
+					for (size_t c=0; c<_M; ++c)
+					{
+						size_t p(c);
+
+						for (size_t i=c+1; i<_M; ++i) if (std::abs(_A[i][c])>std::abs(_A[p][c])) p=i;
+
+						std::swap(_A[c], _A[p]); std::swap(_R[c], _R[p]);
+
+						for (size_t i=c+1; i<_M; ++i)
+						{
+							const double f(_A[i][c]/_A[c][c]);
+
+							for (size_t j=c; j<_M; ++j) _A[i][j] -= f*_A[c][j];
+
+							_R[i] -= f*_R[c];
+						}
+					}
+
+					for (size_t c=_M; c>0; --c)
+					{
+						for (size_t j=c; j<_M; ++j) _R[c-1] -= _A[c-1][j]*_R[j];
+
+						_R[c-1] /= _A[c-1][c-1];
+					}
+
+					// h -= J' y
+					for (size_t k=0; k<_L; ++k) for (size_t m=0; m<_M; ++m) _H[k] -= _J[m][k]*_R[m];
+				}
+
+				return _H;
+			}
+
+			static auto _step(const bool& _Odd, const laurent& t) ->step
+			{
+				return step{_Odd, t._Lo, std::vector<T>(t._C.cbegin(), t._C.cend())};
+			}
+
+			void _factor(const double* _Tab, const size_t& _L)
+			{
+				const std::vector<double> _H(_refine(_Tab, _L));
+
+				// polyphase components, degree m holds the tap 2m (even) or 2m+1 (odd)
+
+				std::vector<double> _He, _Ho, _Ge, _Go;
+
+				for (size_t i=0; i<_L; i+=2)
+				{
+					_He.push_back(_H[i]); _Ho.push_back(_H[i+1]);
+
+					_Ge.push_back(_H[_L-i-1]); _Go.push_back(-_H[_L-i-2]); // g[i]= (-1)^i h[L-i-1]
+				}
+
+				laurent a(0, _He), b(0, _Ho), ge(0, _Ge), go(0, _Go);
+
+				while (!a.empty() && !b.empty())
+				{
+					if (a.span()>=b.span())
+					{// column 0 -= t column 1, forward step: odd += t*even
+						const laurent t(_reduce(a, b));
+
+						ge.sub(go, t);
+
+						_Steps.push_back(_step(true, t));
+					}
+
+					else
+					{// column 1 -= t column 0, forward step: even += t*odd
+						const laurent t(_reduce(b, a));
+
+						go.sub(ge, t);
+
+						_Steps.push_back(_step(false, t));
+					}
+				}
+
+				// the gcd is a monomial: [a 0; ge go] or [0 b; ge go], the determinant
+				// makes go (ge) a monomial as well, a last step clears ge (go)
+
+				_LoOdd = a.empty();
+
+				const laurent& _Top(_LoOdd? b: a); // scaling
+
+				laurent& _Diag(_LoOdd? ge: go), & _Off(_LoOdd? go: ge); // wavelet
+
+				const size_t _Tm(_Top.dominant()), _Dm(_Diag.dominant());
+
+				_Scale[0]=static_cast<T>(_Top._C[_Tm]); _Shift[0]=_Top._Lo+static_cast<ptrdiff_t>(_Tm);
+
+				_Scale[1]=static_cast<T>(_Diag._C[_Dm]); _Shift[1]=_Diag._Lo+static_cast<ptrdiff_t>(_Dm);
+
+				laurent t(_Off._Lo-_Shift[1], _Off._C); // _Off / _Diag
+
+				t.trim(1e-9);
+
+				for (size_t k=0; k<t._C.size(); ++k) t._C[k]/=_Diag._C[_Dm];
+
+				if (!t.empty()) _Steps.push_back(_step(!_LoOdd, t));
+
+				// trailing steps on the wavelet channel, restricted by the theorem
+				_Tail=_Steps.size();
+
+				while (_Tail && _Steps[_Tail-1]._Odd==!_LoOdd) --_Tail;
+			}
+
+
+			std::vector<step>		_Steps;			// lifting steps, forward order
+			bool					_LoOdd;			// scaling coefficients from the odd samples
+			T						_Scale[2];		// scaling, wavelet channel
+			ptrdiff_t				_Shift[2];		// ...
+			size_t					_Tail;			// first of the trailing steps on the wavelet channel
+		};
+
+		typedef step_t<double>				step;
+		typedef factorization_t<double>		factorization;
+	}
+}
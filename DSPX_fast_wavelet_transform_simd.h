@@ -0,0 +1,648 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// SIMD convolution kernels of the fast wavelet transform
+// AVX2 and AVX-512 paths, selected at runtime, double and float
+
+// the kernels work on polyphase (even/odd) copies of the source, extended
+// with a wrapped tail, so that the stride 2 convolution becomes a unit stride
+// one over several output coefficients at once. Multiplications and additions
+// are issued in the same order as the scalar loops: results are bit identical.
+// The batch kernels interleave several windows instead, one per lane
+
+#pragma once
+
+
+namespace fast_wavelet_transform
+{
+	namespace simd
+	{
+		enum isa_type { isa_scalar, isa_avx2, isa_avx512 };
+
+		inline auto isa_name(const isa_type& _Isa) ->const char*
+		{
+			switch (_Isa)
+			{
+				case isa_avx2: return "AVX2";
+				case isa_avx512: return "AVX-512";
+				default: break;
+			}
+
+			return "scalar";
+		}
+
+		inline auto _detect_isa() ->isa_type
+		{
+			int _R[4];
+
+			__cpuid(_R, 0);
+
+			if (_R[0] < 7) return isa_scalar; // no extended features leaf
+
+			__cpuid(_R, 1);
+
+			const bool _Osxsave((_R[2] >> 27) & 1), _Avx((_R[2] >> 28) & 1);
+
+			if (!_Osxsave || !_Avx) return isa_scalar;
+
+			const unsigned long long _Xcr0(_xgetbv(0)); // OS saves the registers state?
+
+			if ((_Xcr0 & 0x6) != 0x6) return isa_scalar; // xmm, ymm
+
+			__cpuidex(_R, 7, 0);
+
+			const bool _Avx2((_R[1] >> 5) & 1), _Avx512f((_R[1] >> 16) & 1);
+
+			if (_Avx512f && (_Xcr0 & 0xe6) == 0xe6) return isa_avx512; // ... opmask, zmm
+
+			if (_Avx2) return isa_avx2;
+
+			return isa_scalar;
+		}
+
+		inline auto detect_isa() ->isa_type
+		{// best instruction set of this CPU, detected once
+			static const isa_type _Isa(_detect_isa());
+
+			return _Isa;
+		}
+
+
+		// polyphase helpers
+
+		template <class T>
+		inline void split(const T* _Src, const size_t& _N,
+							T* _Even, T* _Odd, const size_t& _Tail)
+		{
+			// _Even[k]=_Src[2k], _Odd[k]=_Src[2k+1], k in [0, _N/2),
+			// then _Tail wrapped samples: _Even[_N/2+m]=_Even[m]
+
+			const size_t _Half(_N >> 1);
+
+			for (size_t k=0; k<_Half; ++k)
+			{
+				_Even[k] = _Src[2*k]; _Odd[k] = _Src[2*k+1];
+			}
+
+			for (size_t m=0; m<_Tail; ++m)
+			{
+				_Even[_Half+m] = _Even[m]; _Odd[_Half+m] = _Odd[m];
+			}
+		}
+
+		template <class T>
+		inline void rotate(const T* _Src, const size_t& _Half, const size_t& _Shift,
+							T* _Ext, const size_t& _Len)
+		{
+			// _Ext[k]=_Src[(k+_Half-_Shift)%_Half], k in [0, _Len): the inverse
+			// transform reads its inputs from _Shift positions back, wrapped
+
+			for (size_t k=0, i=_Half-_Shift; k<_Len; ++k, ++i)
+			{
+				if (i==_Half) i=0;
+
+				_Ext[k] = _Src[i];
+			}
+		}
+
+
+		// vector registers of each instruction set and scalar type
+
+		template <isa_type _Isa, class T>
+		struct vec /*undef*/;
+
+		template <>
+		struct vec <isa_avx2, double>
+		{
+			typedef __m256d		type;
+
+			static const size_t width = 4;
+
+			static type zero() { return _mm256_setzero_pd(); }
+			static type load(const double* p) { return _mm256_loadu_pd(p); }
+			static void store(double* p, const type& v) { _mm256_storeu_pd(p, v); }
+			static type set1(const double& x) { return _mm256_set1_pd(x); }
+			static type add(const type& a, const type& b) { return _mm256_add_pd(a, b); }
+			static type mul(const type& a, const type& b) { return _mm256_mul_pd(a, b); }
+
+			static void store_interleaved(double* p, const type& e, const type& o)
+			{// p[2k]=e[k], p[2k+1]=o[k]
+				const type _L(_mm256_unpacklo_pd(e, o)), _U(_mm256_unpackhi_pd(e, o));
+
+				_mm256_storeu_pd(p, _mm256_permute2f128_pd(_L, _U, 0x20));
+
+				_mm256_storeu_pd(p+4, _mm256_permute2f128_pd(_L, _U, 0x31));
+			}
+		};
+
+		template <>
+		struct vec <isa_avx2, float>
+		{
+			typedef __m256		type;
+
+			static const size_t width = 8;
+
+			static type zero() { return _mm256_setzero_ps(); }
+			static type load(const float* p) { return _mm256_loadu_ps(p); }
+			static void store(float* p, const type& v) { _mm256_storeu_ps(p, v); }
+			static type set1(const float& x) { return _mm256_set1_ps(x); }
+			static type add(const type& a, const type& b) { return _mm256_add_ps(a, b); }
+			static type mul(const type& a, const type& b) { return _mm256_mul_ps(a, b); }
+
+			static void store_interleaved(float* p, const type& e, const type& o)
+			{// unpack works within 128 bit lanes, as for double
+				const type _L(_mm256_unpacklo_ps(e, o)), _U(_mm256_unpackhi_ps(e, o));
+
+				_mm256_storeu_ps(p, _mm256_permute2f128_ps(_L, _U, 0x20));
+
+				_mm256_storeu_ps(p+8, _mm256_permute2f128_ps(_L, _U, 0x31));
+			}
+		};
+
+		template <>
+		struct vec <isa_avx512, double>
+		{
+			typedef __m512d		type;
+
+			static const size_t width = 8;
+
+			static type zero() { return _mm512_setzero_pd(); }
+			static type load(const double* p) { return _mm512_loadu_pd(p); }
+			static void store(double* p, const type& v) { _mm512_storeu_pd(p, v); }
+			static type set1(const double& x) { return _mm512_set1_pd(x); }
+			static type add(const type& a, const type& b) { return _mm512_add_pd(a, b); }
+			static type mul(const type& a, const type& b) { return _mm512_mul_pd(a, b); }
+
+			static void store_interleaved(double* p, const type& e, const type& o)
+			{// interleaving indices, bit 3 selects o
+				const __m512i _Idx0(_mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0));
+				const __m512i _Idx1(_mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4));
+
+				_mm512_storeu_pd(p, _mm512_permutex2var_pd(e, _Idx0, o));
+
+				_mm512_storeu_pd(p+8, _mm512_permutex2var_pd(e, _Idx1, o));
+			}
+		};
+
+		template <>
+		struct vec <isa_avx512, float>
+		{
+			typedef __m512		type;
+
+			static const size_t width = 16;
+
+			static type zero() { return _mm512_setzero_ps(); }
+			static type load(const float* p) { return _mm512_loadu_ps(p); }
+			static void store(float* p, const type& v) { _mm512_storeu_ps(p, v); }
+			static type set1(const float& x) { return _mm512_set1_ps(x); }
+			static type add(const type& a, const type& b) { return _mm512_add_ps(a, b); }
+			static type mul(const type& a, const type& b) { return _mm512_mul_ps(a, b); }
+
+			static void store_interleaved(float* p, const type& e, const type& o)
+			{// interleaving indices, bit 4 selects o
+				const __m512i _Idx0(_mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0));
+				const __m512i _Idx1(_mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8));
+
+				_mm512_storeu_ps(p, _mm512_permutex2var_ps(e, _Idx0, o));
+
+				_mm512_storeu_ps(p+16, _mm512_permutex2var_ps(e, _Idx1, o));
+			}
+		};
+
+
+		template <size_t _FilterN, class T>
+		struct scalar_kernels
+		{
+			static void analysis(const T* _Even, const T* _Odd,
+						const T* _H, const T* _G,
+							T* _Lo, T* _Hi, const size_t& _Count)
+			{// _Lo[i]= sum_z s[2i+z]*_H[z], _Hi[i]= sum_z s[2i+z]*_G[z]
+
+				for (size_t i=0; i<_Count; ++i)
+				{
+					T _A(0), _D(0);
+
+					for (size_t m=0; m<_FilterN; ++m)
+					{
+						_A += _Even[i+m]*_H[2*m]; _D += _Even[i+m]*_G[2*m];
+
+						_A += _Odd[i+m]*_H[2*m+1]; _D += _Odd[i+m]*_G[2*m+1];
+					}
+
+					_Lo[i]=_A; _Hi[i]=_D;
+				}
+			}
+
+			static void analysis_low(const T* _Even, const T* _Odd,
+						const T* _H, T* _Lo, const size_t& _Count)
+			{// scaling convolution only, details are copied by the theorem
+
+				for (size_t i=0; i<_Count; ++i)
+				{
+					T _A(0);
+
+					for (size_t m=0; m<_FilterN; ++m)
+					{
+						_A += _Even[i+m]*_H[2*m];
+
+						_A += _Odd[i+m]*_H[2*m+1];
+					}
+
+					_Lo[i]=_A;
+				}
+			}
+
+			static void synthesis(const T* _Lo, const T* _Hi,
+						const T* _Ih, const T* _Ig,
+							T* _Out, const size_t& _Count)
+			{// _Out[2p]= sum_z _Lo[p+z]*_Ih[2z] + _Hi[p+z]*_Ih[2z+1], _Out[2p+1] with _Ig
+
+				for (size_t p=0; p<_Count; ++p)
+				{
+					T _E(0), _O(0);
+
+					for (size_t z=0; z<_FilterN; ++z)
+					{
+						_E += _Lo[p+z]*_Ih[2*z] + _Hi[p+z]*_Ih[2*z+1];
+
+						_O += _Lo[p+z]*_Ig[2*z] + _Hi[p+z]*_Ig[2*z+1];
+					}
+
+					_Out[2*p]=_E; _Out[2*p+1]=_O;
+				}
+			}
+		};
+
+		template <isa_type _Isa, size_t _FilterN, class T>
+		struct vector_kernels
+		{
+			// vec<_Isa, T>::width coefficients per iteration, 
+			// the remainder goes to the kernels of the previous instruction set
+
+			typedef vec<_Isa, T>											V;
+			typedef typename V::type										type;
+
+			typedef typename std::conditional<_Isa==isa_avx512, 
+				vector_kernels<isa_avx2, _FilterN, T>, scalar_kernels<_FilterN, T>>::type	remainder_kernels;
+
+			static void analysis(const T* _Even, const T* _Odd,
+						const T* _H, const T* _G,
+							T* _Lo, T* _Hi, const size_t& _Count)
+			{
+				size_t i(0);
+
+				for (; i+V::width<=_Count; i+=V::width)
+				{
+					type _A(V::zero()), _D(V::zero());
+
+					for (size_t m=0; m<_FilterN; ++m)
+					{
+						const type _E(V::load(_Even+i+m)), _O(V::load(_Odd+i+m));
+
+						_A = V::add(_A, V::mul(_E, V::set1(_H[2*m])));
+						_D = V::add(_D, V::mul(_E, V::set1(_G[2*m])));
+
+						_A = V::add(_A, V::mul(_O, V::set1(_H[2*m+1])));
+						_D = V::add(_D, V::mul(_O, V::set1(_G[2*m+1])));
+					}
+
+					V::store(_Lo+i, _A); V::store(_Hi+i, _D);
+				}
+
+				remainder_kernels::analysis(_Even+i, _Odd+i, _H, _G, _Lo+i, _Hi+i, _Count-i);
+			}
+
+			static void analysis_low(const T* _Even, const T* _Odd,
+						const T* _H, T* _Lo, const size_t& _Count)
+			{
+				size_t i(0);
+
+				for (; i+V::width<=_Count; i+=V::width)
+				{
+					type _A(V::zero());
+
+					for (size_t m=0; m<_FilterN; ++m)
+					{
+						_A = V::add(_A, V::mul(V::load(_Even+i+m), V::set1(_H[2*m])));
+
+						_A = V::add(_A, V::mul(V::load(_Odd+i+m), V::set1(_H[2*m+1])));
+					}
+
+					V::store(_Lo+i, _A);
+				}
+
+				remainder_kernels::analysis_low(_Even+i, _Odd+i, _H, _Lo+i, _Count-i);
+			}
+
+			static void synthesis(const T* _Lo, const T* _Hi,
+						const T* _Ih, const T* _Ig,
+							T* _Out, const size_t& _Count)
+			{
+				size_t p(0);
+
+				for (; p+V::width<=_Count; p+=V::width)
+				{// output pairs
+					type _E(V::zero()), _O(V::zero());
+
+					for (size_t z=0; z<_FilterN; ++z)
+					{
+						const type _A(V::load(_Lo+p+z)), _D(V::load(_Hi+p+z));
+
+						_E = V::add(_E, V::add(V::mul(_A, V::set1(_Ih[2*z])), V::mul(_D, V::set1(_Ih[2*z+1]))));
+
+						_O = V::add(_O, V::add(V::mul(_A, V::set1(_Ig[2*z])), V::mul(_D, V::set1(_Ig[2*z+1]))));
+					}
+
+					V::store_interleaved(_Out+2*p, _E, _O);
+				}
+
+				remainder_kernels::synthesis(_Lo+p, _Hi+p, _Ih, _Ig, _Out+2*p, _Count-p);
+			}
+		};
+
+		// batches of windows, interleaved (structure of arrays): row k holds the sample k 
+		// of vec<_Isa, T>::width windows, so that the vector lanes span the windows
+
+		template <class T>
+		inline void interleave(const T* _Src, const size_t& _Hop, const size_t& _Width, 
+							const size_t& _N, T* _Soa)
+		{// _Soa[k*_Width+l]=_Src[l*_Hop+k], k in [0, _N), l in [0, _Width)
+
+			for (size_t l=0; l<_Width; ++l)
+			{
+				const T* _Win(_Src + l*_Hop);
+
+				for (size_t k=0; k<_N; ++k) _Soa[k*_Width+l] = _Win[k];
+			}
+		}
+
+		template <class T>
+		inline void deinterleave(const T* _Soa, const size_t& _Width, 
+							const size_t& _N, T* _Dest)
+		{// _Dest[l*_N+k]=_Soa[k*_Width+l]: rows of _N values, inverse of interleave()
+
+			for (size_t l=0; l<_Width; ++l)
+			{
+				T* _Row(_Dest + l*_N);
+
+				for (size_t k=0; k<_N; ++k) _Row[k] = _Soa[k*_Width+l];
+			}
+		}
+
+		template <class T>
+		inline void rotate_rows(const T* _Src, const size_t& _Half, const size_t& _Shift, 
+							const size_t& _Lanes, T* _Ext, const size_t& _Len)
+		{// rotate() of interleaved series, rows of _Lanes values
+
+			for (size_t k=0, i=_Half-_Shift; k<_Len; ++k, ++i)
+			{
+				if (i==_Half) i=0;
+
+				std::copy(_Src + i*_Lanes, _Src + (i+1)*_Lanes, _Ext + k*_Lanes);
+			}
+		}
+
+		template <isa_type _Isa, size_t _FilterN, class T>
+		struct batch_kernels
+		{
+			// width lanes of interleaved series, rows _Stride values apart, one series per lane:
+			// the taps are summed in the order of the scalar convolution
+
+			typedef vec<_Isa, T>					V;
+			typedef typename V::type				type;
+
+			static const size_t width = V::width;
+
+			static void analysis(const T* _Soa, const size_t& _Stride, 
+						const T* _H, const T* _G,
+							T* _Lo, T* _Hi, const size_t& _Count)
+			{// _Lo[i]= sum_z s[2i+z]*_H[z], _Hi[i]= sum_z s[2i+z]*_G[z], by rows
+
+				for (size_t i=0; i<_Count; ++i)
+				{
+					const T* _S(_Soa + 2*i*_Stride);
+
+					type _A(V::zero()), _D(V::zero());
+
+					for (size_t z=0; z<2*_FilterN; ++z)
+					{
+						const type _X(V::load(_S + z*_Stride));
+
+						_A = V::add(_A, V::mul(_X, V::set1(_H[z])));
+						_D = V::add(_D, V::mul(_X, V::set1(_G[z])));
+					}
+
+					V::store(_Lo + i*_Stride, _A); V::store(_Hi + i*_Stride, _D);
+				}
+			}
+
+			static void analysis_low(const T* _Soa, const size_t& _Stride, 
+						const T* _H, T* _Lo, const size_t& _Count)
+			{// scaling convolution only, details are copied by the theorem
+
+				for (size_t i=0; i<_Count; ++i)
+				{
+					const T* _S(_Soa + 2*i*_Stride);
+
+					type _A(V::zero());
+
+					for (size_t z=0; z<2*_FilterN; ++z)
+					
+						_A = V::add(_A, V::mul(V::load(_S + z*_Stride), V::set1(_H[z])));
+
+					V::store(_Lo + i*_Stride, _A);
+				}
+			}
+
+			static void synthesis(const T* _Lo, const T* _Hi, const size_t& _Stride, 
+						const T* _Ih, const T* _Ig,
+							T* _Out, const size_t& _Count)
+			{// rows 2p and 2p+1 of _Out, see scalar_kernels::synthesis()
+
+				for (size_t p=0; p<_Count; ++p)
+				{
+					type _E(V::zero()), _O(V::zero());
+
+					for (size_t z=0; z<_FilterN; ++z)
+					{
+						const type _A(V::load(_Lo + (p+z)*_Stride)), _D(V::load(_Hi + (p+z)*_Stride));
+
+						_E = V::add(_E, V::add(V::mul(_A, V::set1(_Ih[2*z])), V::mul(_D, V::set1(_Ih[2*z+1]))));
+
+						_O = V::add(_O, V::add(V::mul(_A, V::set1(_Ig[2*z])), V::mul(_D, V::set1(_Ig[2*z+1]))));
+					}
+
+					V::store(_Out + 2*p*_Stride, _E); V::store(_Out + (2*p+1)*_Stride, _O);
+				}
+			}
+		};
+
+		template <size_t _FilterN, class T>
+		struct batch_kernels <isa_scalar, _FilterN, T>
+		{
+			// one lane
+
+			static const size_t width = 1;
+
+			static void analysis(const T* _Soa, const size_t& _Stride, 
+						const T* _H, const T* _G,
+							T* _Lo, T* _Hi, const size_t& _Count)
+			{
+				for (size_t i=0; i<_Count; ++i)
+				{
+					const T* _S(_Soa + 2*i*_Stride);
+
+					T _A(0), _D(0);
+
+					for (size_t z=0; z<2*_FilterN; ++z)
+					{
+						_A += _S[z*_Stride]*_H[z]; _D += _S[z*_Stride]*_G[z];
+					}
+
+					_Lo[i*_Stride]=_A; _Hi[i*_Stride]=_D;
+				}
+			}
+
+			static void analysis_low(const T* _Soa, const size_t& _Stride, 
+						const T* _H, T* _Lo, const size_t& _Count)
+			{
+				for (size_t i=0; i<_Count; ++i)
+				{
+					const T* _S(_Soa + 2*i*_Stride);
+
+					T _A(0);
+
+					for (size_t z=0; z<2*_FilterN; ++z) _A += _S[z*_Stride]*_H[z];
+
+					_Lo[i*_Stride]=_A;
+				}
+			}
+
+			static void synthesis(const T* _Lo, const T* _Hi, const size_t& _Stride, 
+						const T* _Ih, const T* _Ig,
+							T* _Out, const size_t& _Count)
+			{
+				for (size_t p=0; p<_Count; ++p)
+				{
+					T _E(0), _O(0);
+
+					for (size_t z=0; z<_FilterN; ++z)
+					{
+						const T _A(_Lo[(p+z)*_Stride]), _D(_Hi[(p+z)*_Stride]);
+
+						_E += _A*_Ih[2*z] + _D*_Ih[2*z+1];
+
+						_O += _A*_Ig[2*z] + _D*_Ig[2*z+1];
+					}
+
+					_Out[2*p*_Stride]=_E; _Out[(2*p+1)*_Stride]=_O;
+				}
+			}
+		};
+
+		template <size_t _FilterN, class T>
+		struct lane_kernels
+		{
+			// runtime dispatch over _Lanes interleaved series: groups of the widest vector, 
+			// the remaining lanes go to the narrower instruction sets, then one at a time
+
+			static void analysis(const isa_type& _Isa, const T* _Soa, const size_t& _Lanes, 
+						const T* _H, const T* _G,
+							T* _Lo, T* _Hi, const size_t& _Count)
+			{
+				size_t l(0);
+
+				if (_Isa>=isa_avx512) l=_groups<isa_avx512>(l, _Lanes, [&](const size_t& k) 
+					{ batch_kernels<isa_avx512, _FilterN, T>::analysis(_Soa+k, _Lanes, _H, _G, _Lo+k, _Hi+k, _Count); });
+
+				if (_Isa>=isa_avx2) l=_groups<isa_avx2>(l, _Lanes, [&](const size_t& k) 
+					{ batch_kernels<isa_avx2, _FilterN, T>::analysis(_Soa+k, _Lanes, _H, _G, _Lo+k, _Hi+k, _Count); });
+
+				for (; l<_Lanes; ++l) batch_kernels<isa_scalar, _FilterN, T>::analysis(_Soa+l, _Lanes, _H, _G, _Lo+l, _Hi+l, _Count);
+			}
+
+			static void analysis_low(const isa_type& _Isa, const T* _Soa, const size_t& _Lanes, 
+						const T* _H, T* _Lo, const size_t& _Count)
+			{
+				size_t l(0);
+
+				if (_Isa>=isa_avx512) l=_groups<isa_avx512>(l, _Lanes, [&](const size_t& k) 
+					{ batch_kernels<isa_avx512, _FilterN, T>::analysis_low(_Soa+k, _Lanes, _H, _Lo+k, _Count); });
+
+				if (_Isa>=isa_avx2) l=_groups<isa_avx2>(l, _Lanes, [&](const size_t& k) 
+					{ batch_kernels<isa_avx2, _FilterN, T>::analysis_low(_Soa+k, _Lanes, _H, _Lo+k, _Count); });
+
+				for (; l<_Lanes; ++l) batch_kernels<isa_scalar, _FilterN, T>::analysis_low(_Soa+l, _Lanes, _H, _Lo+l, _Count);
+			}
+
+			static void synthesis(const isa_type& _Isa, const T* _Lo, const T* _Hi, const size_t& _Lanes, 
+						const T* _Ih, const T* _Ig,
+							T* _Out, const size_t& _Count)
+			{
+				size_t l(0);
+
+				if (_Isa>=isa_avx512) l=_groups<isa_avx512>(l, _Lanes, [&](const size_t& k) 
+					{ batch_kernels<isa_avx512, _FilterN, T>::synthesis(_Lo+k, _Hi+k, _Lanes, _Ih, _Ig, _Out+k, _Count); });
+
+				if (_Isa>=isa_avx2) l=_groups<isa_avx2>(l, _Lanes, [&](const size_t& k) 
+					{ batch_kernels<isa_avx2, _FilterN, T>::synthesis(_Lo+k, _Hi+k, _Lanes, _Ih, _Ig, _Out+k, _Count); });
+
+				for (; l<_Lanes; ++l) batch_kernels<isa_scalar, _FilterN, T>::synthesis(_Lo+l, _Hi+l, _Lanes, _Ih, _Ig, _Out+l, _Count);
+			}
+
+		private:
+
+			template <isa_type _I, class _Kernel>
+			static auto _groups(size_t l, const size_t& _Lanes, const _Kernel& _K) ->size_t
+			{// whole groups of lanes from l, returns the first lane left
+				const size_t _W(batch_kernels<_I, _FilterN, T>::width);
+
+				for (; l+_W<=_Lanes; l+=_W) _K(l);
+
+				return l;
+			}
+		};
+
+		template <size_t _FilterN, class T>
+		struct kernels
+		{
+			// runtime dispatch, one switch per level, outside the convolution loops
+
+			static void analysis(const isa_type& _Isa, const T* _Even, const T* _Odd,
+						const T* _H, const T* _G,
+							T* _Lo, T* _Hi, const size_t& _Count)
+			{
+				switch (_Isa)
+				{
+					case isa_avx512: vector_kernels<isa_avx512, _FilterN, T>::analysis(_Even, _Odd, _H, _G, _Lo, _Hi, _Count); return;
+					case isa_avx2: vector_kernels<isa_avx2, _FilterN, T>::analysis(_Even, _Odd, _H, _G, _Lo, _Hi, _Count); return;
+					default: scalar_kernels<_FilterN, T>::analysis(_Even, _Odd, _H, _G, _Lo, _Hi, _Count); return;
+				}
+			}
+
+			static void analysis_low(const isa_type& _Isa, const T* _Even, const T* _Odd,
+						const T* _H, T* _Lo, const size_t& _Count)
+			{
+				switch (_Isa)
+				{
+					case isa_avx512: vector_kernels<isa_avx512, _FilterN, T>::analysis_low(_Even, _Odd, _H, _Lo, _Count); return;
+					case isa_avx2: vector_kernels<isa_avx2, _FilterN, T>::analysis_low(_Even, _Odd, _H, _Lo, _Count); return;
+					default: scalar_kernels<_FilterN, T>::analysis_low(_Even, _Odd, _H, _Lo, _Count); return;
+				}
+			}
+
+			static void synthesis(const isa_type& _Isa, const T* _Lo, const T* _Hi,
+						const T* _Ih, const T* _Ig,
+							T* _Out, const size_t& _Count)
+			{
+				switch (_Isa)
+				{
+					case isa_avx512: vector_kernels<isa_avx512, _FilterN, T>::synthesis(_Lo, _Hi, _Ih, _Ig, _Out, _Count); return;
+					case isa_avx2: vector_kernels<isa_avx2, _FilterN, T>::synthesis(_Lo, _Hi, _Ih, _Ig, _Out, _Count); return;
+					default: scalar_kernels<_FilterN, T>::synthesis(_Lo, _Hi, _Ih, _Ig, _Out, _Count); return;
+				}
+			}
+		};
+	}
+}
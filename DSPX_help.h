@@ -10,6 +10,22 @@ namespace predictor_system
 	// streams
 
 	inline void set_stream(std::ostream& _S) {_S << std::fixed << std::setprecision(8);}
+
+	template <class T> inline void binary_put(std::ostream& _S, const T& _V) { _S.write(reinterpret_cast<const char*>(&_V), sizeof(T)); }
+
+	template <class T> inline void binary_get(std::istream& _S, T& _V) { _S.read(reinterpret_cast<char*>(&_V), sizeof(T)); }
+
+	class memory_streambuf : public std::streambuf
+	{// read only stream buffer over a memory range, e.g. a mapped file: no copy
+	public:
+
+		memory_streambuf(const char* _Beg, const size_t& _Sz)
+		{
+			char* _P(const_cast<char*>(_Beg)); 
+			
+			setg(_P, _P, _P + _Sz);
+		}
+	};
 	
 	
 	// mem
@@ -23,4 +39,64 @@ namespace predictor_system
 			if (*I) { delete *I; *I=0; } 
 	}
 
+	template <class T>
+	class fixed_array
+	{
+		// contiguous objects constructed in place, up to a capacity reserved once: 
+		// the elements are never relocated, T need be neither copyable nor movable
+
+	public:
+
+		fixed_array() : _Data(0), _Size(0), _Capacity(0) {}
+
+		~fixed_array() 
+		{
+			while (_Size) _Data[--_Size].~T();
+
+			::operator delete(_Data);
+		}
+
+		void reserve(const size_t& _N)
+		{// before the first emplace_back()
+			if (_Size) throw std::exception("fixed array failure, not empty");
+
+			::operator delete(_Data); _Data = 0; _Capacity = 0;
+
+			if (_N) _Data = static_cast<T*>(::operator new(_N*sizeof(T)));
+
+			_Capacity = _N;
+		}
+
+		template <class... _Args>
+		auto emplace_back(_Args&&... _A) ->T&
+		{
+			if (_Size == _Capacity) throw std::exception("fixed array failure, capacity exceeded");
+
+			T* _P = new (_Data + _Size) T(std::forward<_Args>(_A)...);
+
+			++_Size; 
+			
+			return *_P;
+		}
+
+		auto size() const ->size_t {return _Size;}
+
+		auto capacity() const ->size_t {return _Capacity;}
+
+		auto operator[](const size_t& i) ->T& {return _Data[i];}
+
+		auto operator[](const size_t& i) const ->const T& {return _Data[i];}
+
+	private:
+
+		fixed_array(const fixed_array&);	// not copyable
+
+		fixed_array& operator=(const fixed_array&);
+
+
+		T*			_Data;		// raw storage of _Capacity objects
+		size_t		_Size;		// constructed, the front ones
+		size_t		_Capacity;	// ...
+	};
+
 }
\ No newline at end of file
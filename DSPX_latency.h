@@ -0,0 +1,248 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+
+// per phase latency histograms of the engine: define DSPX_LATENCY (see stdafx.h) to compile them in;
+// otherwise the macros below expand to nothing and the engine carries no instrumentation
+
+#define DSPX_LATENCY_CAT2(a, b)		a##b
+#define DSPX_LATENCY_CAT(a, b)		DSPX_LATENCY_CAT2(a, b)
+
+#ifdef DSPX_LATENCY
+#define DSPX_LATENCY_SCOPE(_Histogram)			predictor_system::latency_scope DSPX_LATENCY_CAT(_LatencyScope, __LINE__)(_Histogram)
+#define DSPX_LATENCY_RECORD(_Histogram, _Value)	(_Histogram).record(_Value)
+#else
+#define DSPX_LATENCY_SCOPE(_Histogram)
+#define DSPX_LATENCY_RECORD(_Histogram, _Value)
+#endif
+
+
+namespace predictor_system
+{
+	class latency_histogram
+	{
+		// HDR style histogram of non negative integers (e.g. ns): each power of two is split 
+		// in 2^_SubBits linear buckets, so that a value is reported within 2^-_SubBits of itself.
+		// Fixed size, no allocation; record() is lock free and may be called by several threads
+
+	public:
+
+		latency_histogram() { reset(); }
+
+		~latency_histogram() {}
+
+
+		void record(const std::uint64_t& v)
+		{
+			_Counts[_bucket(v)].fetch_add(1, std::memory_order_relaxed);
+
+			_Count.fetch_add(1, std::memory_order_relaxed); _Sum.fetch_add(v, std::memory_order_relaxed);
+
+			for (std::uint64_t m(_Min.load(std::memory_order_relaxed)); v<m && !_Min.compare_exchange_weak(m, v, std::memory_order_relaxed);) {}
+
+			for (std::uint64_t m(_Max.load(std::memory_order_relaxed)); v>m && !_Max.compare_exchange_weak(m, v, std::memory_order_relaxed);) {}
+		}
+
+		void reset()
+		{
+			for (auto I=_Counts.begin(), E=_Counts.end(); I!=E; ++I) I->store(0);
+
+			_Count=0; _Sum=0; _Min=UINT64_MAX; _Max=0;
+		}
+
+		auto count() const ->std::uint64_t { return _Count; }
+
+		auto lowest() const ->std::uint64_t { return _Count? _Min.load(): 0; }
+
+		auto highest() const ->std::uint64_t { return _Max; }
+
+		auto mean() const ->double { return _Count? double(_Sum)/_Count: 0; }
+
+		auto percentile(const double& p /*e.g. 99*/) const ->std::uint64_t
+		{// highest value of the bucket holding the p-th percentile, highest() at most
+			const std::uint64_t n(_Count);
+
+			if (!n) return 0;
+
+			const std::uint64_t _Rank(std::max<std::uint64_t>(1, std::uint64_t(std::ceil(p/100*n))));
+
+			std::uint64_t _Seen(0);
+
+			for (size_t k=0; k<_Buckets; ++k)
+			{
+				_Seen += _Counts[k].load(std::memory_order_relaxed);
+
+				if (_Seen>=_Rank) return std::min(_highest(k), highest());
+			}
+
+			return highest();
+		}
+
+		void dump(std::ostream& s, const char* _Name) const
+		{// one line
+			s << _Name << ": count " << count() << ", mean " << mean() << ", min " << lowest() 
+				<< ", p50 " << percentile(50) << ", p90 " << percentile(90) << ", p99 " << percentile(99) 
+					<< ", p99.9 " << percentile(99.9) << ", max " << highest() << "\n";
+		}
+
+		void dump_json(std::ostream& s) const
+		{// object of the statistics and the non empty buckets, as [highest value, count] pairs
+			s << "{\"count\": " << count() << ", \"mean\": " << mean() << ", \"min\": " << lowest() 
+				<< ", \"p50\": " << percentile(50) << ", \"p90\": " << percentile(90) << ", \"p99\": " << percentile(99) 
+					<< ", \"p99.9\": " << percentile(99.9) << ", \"max\": " << highest() << ", \"buckets\": [";
+
+			const char* _Sep("");
+
+			for (size_t k=0; k<_Buckets; ++k)
+			{
+				const std::uint64_t c(_Counts[k].load(std::memory_order_relaxed));
+
+				if (c) { s << _Sep << "[" << _highest(k) << ", " << c << "]"; _Sep=", "; }
+			}
+
+			s << "]}";
+		}
+
+	private:
+
+		static const size_t		_SubBits = 5;
+		static const size_t		_Sub = size_t(1) << _SubBits;		// linear buckets of a power of two
+		static const size_t		_Buckets = (64 - _SubBits + 1)*_Sub;
+
+		latency_histogram(const latency_histogram&);	// not copyable
+
+		latency_histogram& operator=(const latency_histogram&);
+
+		static auto _log2(std::uint64_t v) ->size_t
+		{// most significant bit, v>0
+			size_t e(0);
+
+			for (size_t _Shift=32; _Shift; _Shift>>=1) if (v >> _Shift) { v >>= _Shift; e += _Shift; }
+
+			return e;
+		}
+
+		static auto _bucket(const std::uint64_t& v) ->size_t
+		{
+			if (v<_Sub) return size_t(v); // exact
+
+			const size_t e(_log2(v));
+
+			return (e - _SubBits + 1)*_Sub + size_t((v >> (e - _SubBits)) - _Sub);
+		}
+
+		static auto _highest(const size_t& k) ->std::uint64_t
+		{// highest value of bucket k
+			if (k<_Sub) return k;
+
+			const size_t _Shift(k/_Sub - 1);
+
+			return ((std::uint64_t(_Sub + k%_Sub) + 1) << _Shift) - 1;
+		}
+
+
+		std::array<std::atomic<std::uint64_t>, _Buckets>	_Counts;	// counts of each bucket
+		std::atomic<std::uint64_t>							_Count;		// no. of values recorded
+		std::atomic<std::uint64_t>							_Sum;		// ...
+		std::atomic<std::uint64_t>							_Min;		// ...
+		std::atomic<std::uint64_t>							_Max;		// ...
+	};
+
+	class latency_scope
+	{// records the lifetime of the scope, ns
+	public:
+
+		typedef std::chrono::steady_clock		clock_type;
+
+		explicit latency_scope(latency_histogram& _H) : _Histogram(_H), _Start(clock_type::now()) {}
+
+		~latency_scope() 
+		{
+			_Histogram.record(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - _Start).count()));
+		}
+
+	private:
+
+		latency_scope(const latency_scope&);	// not copyable
+
+		latency_scope& operator=(const latency_scope&);
+
+		latency_histogram&			_Histogram;
+		clock_type::time_point		_Start;
+	};
+
+	class engine_latency
+	{// latency histograms of the phases of an engine tick (ns), and retraining passes
+
+	public:
+
+		enum phase_type 
+		{ 
+			phase_forward,		// full transform
+			phase_reduced,		// reduced transform (shift variance theorem)
+			phase_predict,		// predict of one predictor
+			phase_train,		// update of one predictor
+			phase_optimize,		// _optimize()
+			phase_inverse,		// inverse transform
+			phase_count 
+		};
+
+		engine_latency() {}
+
+		~engine_latency() {}
+
+
+		auto operator[] (const phase_type& _P) ->latency_histogram& { return _Phases[_P]; }
+
+		auto operator[] (const phase_type& _P) const ->const latency_histogram& { return _Phases[_P]; }
+
+		auto iterations() ->latency_histogram& { return _Iterations; } // training passes of each update of a predictor
+
+		auto iterations() const ->const latency_histogram& { return _Iterations; }
+
+		static auto phase_name(const phase_type& _P) ->const char*
+		{
+			static const char* _Names[phase_count] = {"forward", "reduced", "predict", "train", "optimize", "inverse"};
+
+			return _Names[_P];
+		}
+
+		void reset()
+		{
+			for (size_t p=0; p<phase_count; ++p) _Phases[p].reset();
+
+			_Iterations.reset();
+		}
+
+		void dump(std::ostream& s) const
+		{// one line each, ns
+			for (size_t p=0; p<phase_count; ++p) _Phases[p].dump(s, phase_name(phase_type(p)));
+
+			_Iterations.dump(s, "train passes");
+		}
+
+		void dump_json(std::ostream& s) const
+		{
+			s << "{";
+
+			for (size_t p=0; p<phase_count; ++p) { s << "\"" << phase_name(phase_type(p)) << "\": "; _Phases[p].dump_json(s); s << ", "; }
+
+			s << "\"train passes\": "; _Iterations.dump_json(s); 
+			
+			s << "}\n";
+		}
+
+	private:
+
+		engine_latency(const engine_latency&);	// not copyable
+
+		engine_latency& operator=(const engine_latency&);
+
+
+		latency_histogram		_Phases[phase_count];	// ns
+		latency_histogram		_Iterations;			// training passes
+	};
+}
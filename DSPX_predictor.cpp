@@ -3,6 +3,7 @@
 // THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 // testing the case study
+// usage: DSPX_predictor [--save FILE | --restore FILE], the engine created and trained, see main()
 
 #include "stdafx.h"
 #include "DSPX_ann_def.h"
@@ -20,11 +21,18 @@
 #include "DSPX_financial_convert.h"
 #include "DSPX_financial_bar.h"
 #include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
 #include "DSPX_fast_wavelet_transform.h"
 #include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
 #include "DSPX_engine.h"
 
 #define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+#define SAVEFLAG		"--save"	// command line: snapshot of the trained engine into FILE
+#define RESTOREFLAG		"--restore"	// command line: continue from the snapshot FILE instead of training
 
 
 
@@ -33,11 +41,8 @@ inline void _Create(engine_type& _Engine, const size_t& PATSIZE, const _Init& _B
 {
 	cout << "creating Matrix Q\n";
 
-	for (auto I = _Beg; I != _End; ++I)
-	{
-		// for each cycle, update engine
-		_Engine.update(I, I+PATSIZE);
-	}
+	// for each cycle, update engine: the transforms are batched
+	_Engine.update_batch(_Beg, _End);
 }
 
 template <class engine_type, class _Init>
@@ -128,7 +133,7 @@ inline void _Test(engine_type& _Engine, const size_t& PATSIZE,
 }
 
 
-int main()
+int main(int argc, char* argv[])
 {
 	// import typenames ...
 	typedef predictor_system::real_type				real_type;
@@ -179,12 +184,35 @@ int main()
 	vector_type::const_iterator BEG = CLOSETRAINEND - _TrainingIterations - QSIZE;
 	vector_type::const_iterator END = BEG + QSIZE;
 
-	_Create(ENGINE, PATSIZE, BEG, END); // creates Q matrix
+	// snapshots, opt-in: no file is read or written without a flag
+	const std::string _Flag(argc > 2? argv[1]: "");
 
-	BEG = END;
-	END = BEG + _TrainingIterations;
+	const path_type S(argc > 2? argv[2]: "");
+
+	if (_Flag == RESTOREFLAG) 
+	{// warm restart, the engine continues as the saved one (saved by this main())
+		cout << "loading engine snapshot " << S.string() << "\n";
+
+		ENGINE.load_snapshot(S);
 
-	_Train(ENGINE, PATSIZE, BEG, END); // trains networks
+		END = BEG + QSIZE + _TrainingIterations;
+	}
+	else
+	{
+		_Create(ENGINE, PATSIZE, BEG, END); // creates Q matrix
+
+		BEG = END;
+		END = BEG + _TrainingIterations;
+
+		_Train(ENGINE, PATSIZE, BEG, END); // trains networks
+
+		if (_Flag == SAVEFLAG) 
+		{// for a later run with RESTOREFLAG
+			ENGINE.save_snapshot(S); 
+
+			cout << "engine snapshot saved to " << S.string() << "\n";
+		}
+	}
 
 	BEG = END;
 	//END = BEG + 20*QSIZE;
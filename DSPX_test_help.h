@@ -0,0 +1,53 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+
+namespace predictor_system
+{
+	// help functions of the tests: engine runs, latencies
+
+	template <class _Engine, class _Init, class _Observer>
+	inline void run_ticks(_Engine& _E, const size_t& _Patsize, const size_t& _Qsize, const size_t& _Ticks, 
+		const _Init& _Beg, _Observer&& _Obs)
+	{
+		// creates matrix Q (_Qsize updates of the windows from _Beg), then _Ticks ticks of predict() and update();
+		// after each tick _Obs(tick no., forecast, newest sample of the window, predict() ns, tick ns)
+
+		typedef std::chrono::steady_clock	clock_type;
+
+		_Init I(_Beg);
+
+		for (const _Init E(I+_Qsize); I!=E; ++I) _E.update(I, I+_Patsize); // creates Q matrix
+
+		for (size_t t=0; t<_Ticks; ++t, ++I)
+		{
+			const auto _Start(clock_type::now());
+
+			const double _Fcst(_E.predict());
+
+			const auto _Predicted(clock_type::now());
+
+			_E.update(I, I+_Patsize);
+
+			const auto _End(clock_type::now());
+
+			_Obs(t, _Fcst, *(I+_Patsize-1), 
+				std::chrono::duration_cast<std::chrono::nanoseconds>(_Predicted-_Start).count(),
+				std::chrono::duration_cast<std::chrono::nanoseconds>(_End-_Start).count());
+		}
+	}
+
+	inline auto percentile(std::vector<long long> _Latency, const size_t& _Pc) ->long long
+	{// _Pc-th percentile of the latencies, 0 if none
+		if (_Latency.empty()) return 0;
+
+		auto _Nth(_Latency.begin() + (_Latency.size()*_Pc)/100);
+
+		std::nth_element(_Latency.begin(), _Nth, _Latency.end());
+
+		return *_Nth;
+	}
+}
@@ -0,0 +1,341 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+
+namespace predictor_system
+{
+	class work_stealing_pool
+	{
+		// fixed set of workers running the indices [0, count) of one parallel_for() at a time.
+		// Each worker owns a range of indices and runs it from the front; an idle worker steals 
+		// the back half of the largest range left. The calling thread is worker 0.
+		// The tasks must be independent: the results do not depend on the schedule.
+		// Nesting: a parallel_for() called by a task of this pool runs inline, on the thread of
+		// the task (the job lock is not reentrant). A call from any other thread, or from a task
+		// of another pool, waits until the running job of this pool has returned
+
+	public:
+
+		explicit work_stealing_pool(const size_t& _Threads=0 /*workers, caller included; 0: all cores*/)
+			: _Slots(std::max<size_t>(1, _Threads? _Threads: std::thread::hardware_concurrency()))
+			, _Workers()
+			, _Body()
+			, _Generation(0)
+			, _Active(0)
+			, _Stop(false)
+			, _Error()
+			, _ErrorIdx(0)
+		{
+			for (size_t k=1; k<_Slots.size(); ++k) _Workers.emplace_back(&work_stealing_pool::_worker, this, k);
+		}
+
+		~work_stealing_pool()
+		{
+			{ std::lock_guard<std::mutex> _L(_Mx); _Stop=true; }
+
+			_Wake.notify_all();
+
+			for (auto I=_Workers.begin(); I!=_Workers.end(); ++I) I->join();
+		}
+
+
+		static auto shared() ->work_stealing_pool& 
+		{// one worker per core, shared by the engines
+			static work_stealing_pool _Pool;
+
+			return _Pool;
+		}
+
+		auto size() const ->size_t { return _Slots.size(); } // no. of workers
+
+		template <class _Task>
+		void parallel_for(const size_t& _Count, const _Task& _T)
+		{
+			// _T(i) for each i in [0, _Count), returns when all are done. 
+			// An exception thrown by a task is rethrown here, that of the lowest index
+
+			if (_Count<2 || _Slots.size()==1 || _running()==this) { for (size_t i=0; i<_Count; ++i) _T(i); return; }
+
+			std::lock_guard<std::mutex> _Job(_JobMx); // one job at a time
+
+			const size_t _W(_Slots.size());
+
+			for (size_t k=0; k<_W; ++k) { _Slots[k]._Beg=k*_Count/_W; _Slots[k]._End=(k+1)*_Count/_W; }
+
+			_Body = [&_T](const size_t& i) { _T(i); };
+
+			_Error = nullptr; _ErrorIdx = _Count;
+
+			{ std::lock_guard<std::mutex> _L(_Mx); ++_Generation; _Active=_W-1; }
+
+			_Wake.notify_all();
+
+			_work(0);
+
+			{ std::unique_lock<std::mutex> _L(_Mx); _Done.wait(_L, [this] { return !_Active; }); }
+
+			_Body = nullptr;
+
+			if (_Error) std::rethrow_exception(_Error);
+		}
+
+	private:
+
+		struct slot
+		{// range of indices left to a worker
+			slot() : _Mx(), _Beg(0), _End(0) {}
+
+			std::mutex		_Mx;
+			size_t			_Beg;
+			size_t			_End;
+		};
+
+		work_stealing_pool(const work_stealing_pool&);	// not copyable
+
+		work_stealing_pool& operator=(const work_stealing_pool&);
+
+		void _worker(const size_t k)
+		{
+			for (size_t _Seen(0);;)
+			{
+				{
+					std::unique_lock<std::mutex> _L(_Mx);
+
+					_Wake.wait(_L, [&] { return _Stop || _Generation!=_Seen; });
+
+					if (_Stop) return;
+
+					_Seen=_Generation;
+				}
+
+				_work(k);
+
+				std::lock_guard<std::mutex> _L(_Mx);
+
+				if (!--_Active) _Done.notify_one();
+			}
+		}
+
+		static auto _running() ->const work_stealing_pool*&
+		{// pool whose task this thread is running, if any
+			static thread_local const work_stealing_pool* _P(nullptr);
+
+			return _P;
+		}
+
+		void _work(const size_t& k)
+		{
+			struct running
+			{// this thread runs tasks of _P, until the scope ends
+				explicit running(const work_stealing_pool* _P) : _Prev(_running()) { _running()=_P; }
+
+				~running() { _running()=_Prev; }
+
+				const work_stealing_pool* _Prev;
+			}
+			_Running(this);
+
+			size_t i(0);
+
+			while (_pop(k, i) || _steal(k, i))
+			{
+				try { _Body(i); }
+
+				catch (...)
+				{
+					std::lock_guard<std::mutex> _L(_ErrorMx);
+
+					if (i<_ErrorIdx) { _ErrorIdx=i; _Error=std::current_exception(); }
+				}
+			}
+		}
+
+		bool _pop(const size_t& k, size_t& i)
+		{// front of the own range
+			slot& _S(_Slots[k]);
+
+			std::lock_guard<std::mutex> _L(_S._Mx);
+
+			if (_S._Beg==_S._End) return false;
+
+			i=_S._Beg++;
+
+			return true;
+		}
+
+		bool _steal(const size_t& k, size_t& i)
+		{
+			// back half of the largest range left: i is its first index, 
+			// the rest becomes the own range. false if no work is left
+
+			for (;;)
+			{
+				size_t _Victim(k), _Largest(0);
+
+				for (size_t v=0; v<_Slots.size(); ++v)
+				{
+					if (v==k) continue;
+
+					std::lock_guard<std::mutex> _L(_Slots[v]._Mx);
+
+					if (_Slots[v]._End-_Slots[v]._Beg > _Largest) { _Largest=_Slots[v]._End-_Slots[v]._Beg; _Victim=v; }
+				}
+
+				if (!_Largest) return false;
+
+				size_t _Beg(0), _End(0);
+
+				{
+					slot& _V(_Slots[_Victim]);
+
+					std::lock_guard<std::mutex> _L(_V._Mx);
+
+					const size_t n(_V._End-_V._Beg);
+
+					if (!n) continue; // taken meanwhile
+
+					_End=_V._End; _Beg=_End-(n+1)/2; _V._End=_Beg;
+				}
+
+				slot& _S(_Slots[k]);
+
+				std::lock_guard<std::mutex> _L(_S._Mx);
+
+				i=_Beg; _S._Beg=_Beg+1; _S._End=_End;
+
+				return true;
+			}
+		}
+
+
+		std::vector<slot>						_Slots;			// ranges of the workers
+		std::vector<std::thread>				_Workers;		// workers 1, 2, ...
+		std::function<void(const size_t&)>		_Body;			// task of the current job
+		std::mutex								_JobMx;			// one parallel_for() at a time
+		std::mutex								_Mx;			// job state
+		std::condition_variable					_Wake;			// a job started, or stop
+		std::condition_variable					_Done;			// all workers done
+		size_t									_Generation;	// no. of jobs started
+		size_t									_Active;		// workers running the current job
+		bool									_Stop;			// destruction
+		std::mutex								_ErrorMx;		// ...
+		std::exception_ptr						_Error;			// exception of the lowest index
+		size_t									_ErrorIdx;		// ...
+	};
+
+	class background_queue
+	{
+		// fixed set of background threads running submitted tasks in FIFO order;
+		// submit() returns at once, the caller does not wait. Used by the asynchronous
+		// retraining of the engine: the tasks own their data until they return
+
+	public:
+
+		explicit background_queue(const size_t& _Threads=0 /*0: all cores*/)
+			: _Workers()
+			, _Tasks()
+			, _Running(0)
+			, _Stop(false)
+			, _Error()
+		{
+			const size_t _W(std::max<size_t>(1, _Threads? _Threads: std::thread::hardware_concurrency()));
+
+			for (size_t k=0; k<_W; ++k) _Workers.emplace_back(&background_queue::_worker, this);
+		}
+
+		~background_queue()
+		{// runs the tasks left
+			{ std::lock_guard<std::mutex> _L(_Mx); _Stop=true; }
+
+			_Wake.notify_all();
+
+			for (auto I=_Workers.begin(); I!=_Workers.end(); ++I) I->join();
+		}
+
+
+		static auto shared() ->background_queue& 
+		{
+			// shared by the engines: the cores work_stealing_pool::shared() leaves free, one at least
+			// (then sharing a core with a worker, which sleeps between the jobs of its ticks)
+
+			static background_queue _Queue(_free_cores());
+
+			return _Queue;
+		}
+
+		auto size() const ->size_t { return _Workers.size(); } // no. of threads
+
+		void submit(std::function<void()> _T)
+		{
+			{ std::lock_guard<std::mutex> _L(_Mx); _Tasks.push_back(std::move(_T)); }
+
+			_Wake.notify_one();
+		}
+
+		void wait()
+		{
+			// returns when no task is queued or running; 
+			// rethrows the first exception thrown by a task since the last wait()
+
+			std::unique_lock<std::mutex> _L(_Mx); 
+			
+			_Idle.wait(_L, [this] { return _Tasks.empty() && !_Running; });
+
+			if (_Error) { std::exception_ptr _E(_Error); _Error=nullptr; std::rethrow_exception(_E); }
+		}
+
+	private:
+
+		background_queue(const background_queue&);	// not copyable
+
+		static auto _free_cores() ->size_t
+		{
+			const size_t _Cores(std::thread::hardware_concurrency()), _Busy(work_stealing_pool::shared().size());
+
+			return (_Cores > _Busy)? _Cores - _Busy: 1;
+		}
+
+		background_queue& operator=(const background_queue&);
+
+		void _worker()
+		{
+			for (;;)
+			{
+				std::function<void()> _T;
+
+				{
+					std::unique_lock<std::mutex> _L(_Mx);
+
+					_Wake.wait(_L, [this] { return _Stop || !_Tasks.empty(); });
+
+					if (_Tasks.empty()) return; // stop, drained
+
+					_T=std::move(_Tasks.front()); _Tasks.pop_front(); ++_Running;
+				}
+
+				std::exception_ptr _E;
+
+				try { _T(); } catch (...) { _E=std::current_exception(); }
+
+				std::lock_guard<std::mutex> _L(_Mx);
+
+				if (_E && !_Error) _Error=_E;
+
+				if (!--_Running && _Tasks.empty()) _Idle.notify_all();
+			}
+		}
+
+
+		std::vector<std::thread>				_Workers;		// background threads
+		std::deque<std::function<void()>>		_Tasks;			// FIFO of the submitted tasks
+		size_t									_Running;		// tasks being run
+		bool									_Stop;			// destruction
+		std::exception_ptr						_Error;			// first exception since the last wait()
+		std::mutex								_Mx;			// queue state
+		std::condition_variable					_Wake;			// a task was submitted, or stop
+		std::condition_variable					_Idle;			// no task queued or running
+	};
+}
@@ -14,6 +14,9 @@
 #include "DSPX_financial_convert.h"
 #include "DSPX_financial_bar.h"
 #include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
 #include "DSPX_fast_wavelet_transform.h"
 
 #define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
@@ -82,11 +85,17 @@ int main()
 			for (size_t i=0; i<PATSIZE; ++i) _AbsError[i] = std::abs(*(_Data+i) - _Reconstruction[i]);
 
 			const real_type _MeanAbsErr(ann::mean(_AbsError));
+
+
+			// point inverse of the newest sample, must match the full inverse
+
+			const bool _PointInverse(D->invert_point(&_Forward[0], PATSIZE, PATSIZE-1) == *_Reconstruction.crbegin());
 			
 
 			// output reconstruction error
 
-			cout << "Test#" << 1+i << ", " << D->wavelet_type() << ", Reconstruction MAE: " << _MeanAbsErr << "\n";
+			cout << "Test#" << 1+i << ", " << D->wavelet_type() << ", Reconstruction MAE: " << _MeanAbsErr 
+				<< ", Point inverse: " << (_PointInverse? "correct":"failed") << "\n";
 		}
 
 		cout << "\n";
@@ -0,0 +1,129 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #10 (ENGINE SNAPSHOT)
+// motivation: to test the warm restart of an engine from a binary snapshot against an uninterrupted run
+// features: Q creation, training and forecasts of an engine; a second engine is saved halfway, 
+// a third one, of different weights, loads the snapshot (mapped) and continues: forecasts must be bit identical;
+// elapsed time of creation and training, save and load
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+#define SNAPFILE		"T10.snap"
+
+typedef std::chrono::steady_clock	clock_type;
+
+
+inline auto _Elapsed(const clock_type::time_point& _Start) ->long long
+{// us
+	return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count();
+}
+
+
+int main()
+{
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE), S(SNAPFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts, the snapshot is taken halfway
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	std::vector<double> _Uninterrupted, _Restarted;
+
+
+	// uninterrupted run
+	ann::_Re = ann::random_engine_type();
+
+	engine_type ENGINE(PATSIZE);
+
+	auto I(CLOSEBEG);
+
+	auto _Start(clock_type::now());
+
+	for (const auto E(I+QSIZE); I!=E; ++I) ENGINE.update(I, I+PATSIZE); // creates Q matrix
+
+	for (const auto E(I+QSIZE); I!=E; ++I) { ENGINE.predict(); ENGINE.update(I, I+PATSIZE); } // trains networks
+
+	const auto _ReplayTime(_Elapsed(_Start));
+
+	for (const auto E(I+MAXFCST); I!=E; ++I) { _Uninterrupted.push_back(ENGINE.predict()); ENGINE.update(I, I+PATSIZE); }
+
+
+	// the same run, saved halfway...
+	ann::_Re = ann::random_engine_type();
+
+	engine_type SAVED(PATSIZE);
+
+	I = CLOSEBEG;
+
+	for (const auto E(I+QSIZE); I!=E; ++I) SAVED.update(I, I+PATSIZE);
+
+	for (const auto E(I+QSIZE+MAXFCST/2); I!=E; ++I) { _Restarted.push_back(SAVED.predict()); SAVED.update(I, I+PATSIZE); }
+
+	_Restarted.erase(_Restarted.begin(), _Restarted.begin()+QSIZE); // training forecasts
+
+	_Start = clock_type::now();
+
+	SAVED.save_snapshot(S);
+
+	const auto _SaveTime(_Elapsed(_Start));
+
+
+	// ... and continued by an engine of other weights
+	ann::_Re.seed(1);
+
+	engine_type LOADED(PATSIZE);
+
+	_Start = clock_type::now();
+
+	LOADED.load_snapshot(S);
+
+	const auto _LoadTime(_Elapsed(_Start));
+
+	for (const auto E(CLOSEBEG+QSIZE+QSIZE+MAXFCST); I!=E; ++I) { _Restarted.push_back(LOADED.predict()); LOADED.update(I, I+PATSIZE); }
+
+
+	cout << "Engine, Daubechies 4, " << _Uninterrupted.size() << " forecasts, restarted halfway: " 
+		<< ((_Uninterrupted==_Restarted)? "bit identical": "failed") << "\n"
+		<< "  elapsed (us), creation and training: " << _ReplayTime << ", save: " << _SaveTime << ", load: " << _LoadTime << "\n";
+
+	return 0;
+}
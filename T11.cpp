@@ -0,0 +1,90 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #11 (LATENCY INSTRUMENTATION)
+// motivation: to find where an engine tick spends its time, and its outliers
+// features: Q creation, training and forecasts of an engine, with and without the optimization;
+// per phase latency histograms dumped as text (console) and JSON (T11.json). Requires DSPX_LATENCY, see stdafx.h
+// output type: console, file
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+#define JSONFILE		"T11.json"
+
+
+int main()
+{
+#ifndef DSPX_LATENCY
+	cout << "define DSPX_LATENCY in stdafx.h to compile the instrumentation in\n";
+
+	return 0;
+#else
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts, half of them optimized
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	engine_type ENGINE(PATSIZE);
+
+	auto I(CLOSEBEG);
+
+	for (const auto E(I+QSIZE); I!=E; ++I) ENGINE.update(I, I+PATSIZE); // creates Q matrix
+
+	for (const auto E(I+QSIZE); I!=E; ++I) { ENGINE.predict(); ENGINE.update(I, I+PATSIZE); } // trains networks
+
+	ENGINE.latency().reset(); // steady state only
+
+	for (const auto E(I+MAXFCST/2); I!=E; ++I) { ENGINE.predict(); ENGINE.update(I, I+PATSIZE); }
+
+	for (const auto E(I+MAXFCST/2); I!=E; ++I) { ENGINE.predict(I, I+PATSIZE); ENGINE.update(I, I+PATSIZE); } // optimized
+
+
+	cout << "Engine, Daubechies 4, " << MAXFCST << " ticks, latency (ns)\n";
+
+	ENGINE.latency().dump(cout);
+
+	std::ofstream fout(JSONFILE);
+
+	ENGINE.latency().dump_json(fout);
+
+	return 0;
+#endif
+}
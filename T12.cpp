@@ -0,0 +1,126 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// TEST #12 (STREAMING PUSH API)
+// motivation: to test the streaming interface of the engine, one sample per bar, against the windows of update()
+// features: Q creation, training and forecasts of two engines, one fed the windows, the other one sample at a time
+// by push() (the window kept by the engine); a third engine loaded from a snapshot of the second one halfway.
+// The forecasts must be bit identical, elapsed time of both
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+typedef std::chrono::steady_clock	clock_type;
+
+
+int main()
+{
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts of each engine
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	std::vector<double> _Windows, _Pushed, _Loaded;
+
+	// windows: update() and predict()
+	ann::_Re = ann::random_engine_type();
+
+	engine_type WINDOWS(PATSIZE);
+
+	auto I(CLOSEBEG);
+
+	auto _Start(clock_type::now());
+
+	for (const auto E(I+QSIZE); I!=E; ++I) WINDOWS.update(I, I+PATSIZE); // creates Q matrix
+
+	for (const auto E(I+QSIZE); I!=E; ++I) { WINDOWS.predict(); WINDOWS.update(I, I+PATSIZE); } // trains networks
+
+	for (const auto E(I+MAXFCST); I!=E; ++I) { _Windows.push_back(WINDOWS.predict()); WINDOWS.update(I, I+PATSIZE); }
+
+	const auto _WindowsTime(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+	// stream: push() and forecast(), the same weights
+	ann::_Re = ann::random_engine_type();
+
+	engine_type STREAM(PATSIZE);
+
+	std::stringstream _Snapshot;
+
+	auto X(CLOSEBEG);
+
+	_Start = clock_type::now();
+
+	STREAM.push(X, X+PATSIZE-1); X += PATSIZE-1; // first window, short of its newest sample
+
+	for (const auto E(X+QSIZE); X!=E; ++X) STREAM.push(*X); // creates Q matrix
+
+	for (const auto E(X+QSIZE); X!=E; ++X) { STREAM.forecast(); STREAM.push(*X); } // trains networks
+
+	for (const auto E(X+MAXFCST); X!=E; ++X) 
+	{
+		if (_Pushed.size() == MAXFCST/2) STREAM.save_snapshot(_Snapshot); // halfway
+
+		_Pushed.push_back(STREAM.forecast()); STREAM.push(*X); 
+	}
+
+	const auto _StreamTime(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+	// loaded: the second half of the stream, restarted from the snapshot
+	engine_type LOADED(PATSIZE);
+
+	LOADED.load_snapshot(_Snapshot);
+
+	for (auto Y(CLOSEBEG+PATSIZE-1+2*QSIZE+MAXFCST/2), E(Y+MAXFCST/2); Y!=E; ++Y) 
+	{ 
+		_Loaded.push_back(LOADED.forecast()); LOADED.push(*Y); 
+	}
+
+	const bool _Identical(std::equal(_Windows.cbegin(), _Windows.cend(), _Pushed.cbegin()));
+
+	const bool _Restarted(std::equal(_Loaded.cbegin(), _Loaded.cend(), _Pushed.cbegin() + MAXFCST/2));
+
+	cout << "Daubechies 4, " << MAXFCST << " forecasts, windows: " << _WindowsTime << " us, push: " << _StreamTime << " us\n";
+
+	cout << "push() forecasts identical to update(): " << (_Identical? "yes": "NO") 
+		<< ", restarted from snapshot identical: " << (_Restarted? "yes": "NO") << "\n";
+
+	return 0;
+}
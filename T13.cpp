@@ -0,0 +1,175 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #13 (COLUMN MAJOR Q)
+// motivation: to compare the layouts of matrix Q read by the MLPs, rows only against rows and column major timelines
+// features: Q creation, training and forecasts of two engines, one with set_column_major(); forecasts must be
+// bit identical, p50 and p99 tick latency (predict and update) of both. Then a cold cache read of the MLP inputs
+// (the newest values of each variant coefficient) of a Q of the same size: time and distinct cache lines touched
+// of each layout, the lines a proxy of the cache misses
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+#include "DSPX_test_help.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+typedef std::chrono::steady_clock	clock_type;
+
+using predictor_system::percentile;
+
+
+template <class engine_type, class _Init>
+inline void _Forecasts(engine_type& _Engine, const size_t& PATSIZE, const size_t& QSIZE,
+		const size_t& MAXTEST, const _Init& _Beg, std::vector<double>& _Fcst, std::vector<long long>& _Latency)
+{
+	// creates matrix Q, trains the machines, then forecasts MAXTEST samples;
+	// the latency (ns) of each tick, predict() and update(), in _Latency
+
+	predictor_system::run_ticks(_Engine, PATSIZE, QSIZE, QSIZE+MAXTEST, _Beg, 
+		[&](size_t, double _F, double, long long, long long _Tick) { _Fcst.push_back(_F); _Latency.push_back(_Tick); });
+}
+
+template <class _Reader>
+inline auto _ColdReads(const size_t& _Passes, std::vector<char>& _Evict, const _Reader& _Read) ->long long
+{// average ns of _Read(), the caches flushed before each pass by walking _Evict
+	long long _Elapsed(0);
+
+	for (size_t p = 0; p < _Passes; ++p)
+	{
+		for (size_t k = 0; k < _Evict.size(); k += 64) ++_Evict[k];
+
+		const auto _Start(clock_type::now());
+
+		_Read();
+
+		_Elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now()-_Start).count();
+	}
+
+	return _Elapsed/_Passes;
+}
+
+inline auto _Line(const double* _P) ->std::uintptr_t {return reinterpret_cast<std::uintptr_t>(_P)/64;}
+
+
+int main()
+{
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts of each engine
+	const size_t DEPTH(9);		// newest values of a coefficient an MLP reads (input size + 1)
+	const size_t PASSES(200);	// cold reads of each layout
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+
+	// the two engines draw the same weights
+	ann::_Re = ann::random_engine_type();
+
+	engine_type ROWS(PATSIZE);
+
+	ann::_Re = ann::random_engine_type();
+
+	engine_type COLUMNS(PATSIZE);
+
+	COLUMNS.set_column_major(true);
+
+	std::vector<double> _RowsFcst, _ColumnsFcst;
+
+	std::vector<long long> _RowsLatency, _ColumnsLatency;
+
+	_Forecasts(ROWS, PATSIZE, QSIZE, MAXFCST, CLOSEBEG, _RowsFcst, _RowsLatency);
+
+	_Forecasts(COLUMNS, PATSIZE, QSIZE, MAXFCST, CLOSEBEG, _ColumnsFcst, _ColumnsLatency);
+
+	cout << "Engine, Daubechies 4, " << _RowsFcst.size() << " forecasts, "
+		<< ((_RowsFcst==_ColumnsFcst)? "bit identical": "failed") << "\n"
+		<< "  tick latency (ns), rows: p50 " << percentile(_RowsLatency, 50) << ", p99 " << percentile(_RowsLatency, 99)
+		<< "; column major: p50 " << percentile(_ColumnsLatency, 50) << ", p99 " << percentile(_ColumnsLatency, 99) << "\n\n";
+
+
+	// a Q of the engine's size, the variant coefficients tracked
+	fwt::shift_variance_theorem _Theorem(PATSIZE, 2);
+
+	std::vector<size_t> _Variant;
+
+	for (size_t i = 0; i < PATSIZE; ++i) if (!_Theorem.is_SVT_coefficient(i)) _Variant.push_back(i);
+
+	fwt::timeline_matrix<double> Q(QSIZE+1, PATSIZE);
+
+	Q.track(_Variant, DEPTH);
+
+	for (auto I(CLOSEBEG); Q.size() < QSIZE; ++I) Q.push_back(&*I); // any values
+
+	std::vector<char> _Evict(size_t(64) << 20); // beyond the last level cache
+
+	double _Sum(0);
+
+	const auto _RowsRead(_ColdReads(PASSES, _Evict, [&]()
+	{
+		for (auto I = _Variant.cbegin(), E = _Variant.cend(); I != E; ++I)
+
+			for (size_t d = Q.size() - DEPTH; d < Q.size(); ++d) _Sum += Q[d][*I];
+	}));
+
+	const auto _ColumnsRead(_ColdReads(PASSES, _Evict, [&]()
+	{
+		for (auto I = _Variant.cbegin(), E = _Variant.cend(); I != E; ++I)
+		{
+			const double* _C(Q.timeline(*I));
+
+			for (size_t d = 0; d < DEPTH; ++d) _Sum += _C[d];
+		}
+	}));
+
+	std::unordered_set<std::uintptr_t> _RowsLines, _ColumnsLines;
+
+	for (auto I = _Variant.cbegin(), E = _Variant.cend(); I != E; ++I)
+	{
+		for (size_t d = Q.size() - DEPTH; d < Q.size(); ++d) _RowsLines.insert(_Line(&Q[d][*I]));
+
+		for (size_t d = 0; d < DEPTH; ++d) _ColumnsLines.insert(_Line(Q.timeline(*I) + d));
+	}
+
+	cout << "Cold read of the MLP inputs, " << _Variant.size() << " variant coefficients x " << DEPTH << " values (checksum " << _Sum << ")\n"
+		<< "  rows: " << _RowsRead << " ns, " << _RowsLines.size() << " cache lines\n"
+		<< "  column major: " << _ColumnsRead << " ns, " << _ColumnsLines.size() << " cache lines\n";
+
+	return 0;
+}
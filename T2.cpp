@@ -15,6 +15,9 @@
 #include "DSPX_financial_convert.h"
 #include "DSPX_financial_bar.h"
 #include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
 #include "DSPX_fast_wavelet_transform.h"
 
 
@@ -87,6 +90,23 @@ struct Q
 		return (_Test == _Out);
 	}
 
+	template <class _Ranit>
+	void batch_transform(const _Ranit& _Beg, const _Ranit& _End)
+	{// save the crystals of the windows starting in [_Beg, _End) into matrix Q, batched transforms
+
+		const size_t _Count(std::distance(_Beg, _End));
+
+		real_vector_type _Out(_Count*source_size());
+
+		_DWT.transform_batch(_Beg._Ptr, &_Out[0], source_size(), _Count, 1 /*hop*/);
+
+		for (size_t k=0; k<_Count; ++k) 
+			
+			_Transforms.push_back(real_vector_type(&_Out[k*source_size()], &_Out[(k+1)*source_size()]));
+	}
+
+	auto crystal(const size_t& i) const ->const real_vector_type& {return _Transforms[i];}
+
 	template <class _Ranit>
 	void theorem_transform(const _Ranit& _Beg, const _Ranit& _End)
 	{// save a new DWT crystal into matrix Q, calculated using the shift variance theorem
@@ -262,5 +282,19 @@ int main()
 	for (auto I = BEG; I < END; ++I) _Q.theorem_transform(I, I + PATSIZE);	// REDUCED TRANSFORM
 	cout << "Reduced Wavelet Transform, Elapsed:\t" << SW.stop().elapsed() << "\n";
 
+
+	SW.reset().start();
+	_Q.batch_transform(BEG, END);	// BATCHED TRANSFORMS
+	cout << "Batched Wavelet Transform, Elapsed:\t" << SW.stop().elapsed() << "\n";
+
+	// batched crystals against the full transforms of the same windows
+	const size_t _Full(_Q.history_size() - 3*EFFICIENCY_TESTS), _Batched(_Q.history_size() - EFFICIENCY_TESTS);
+
+	size_t _Errors(0);
+
+	for (size_t k=0; k<EFFICIENCY_TESTS; ++k) _Errors += (_Q.crystal(_Full+k) != _Q.crystal(_Batched+k));
+
+	cout << "Batched Wavelet Transform:\t" << (_Errors? "Test failed": "Test correct") << "\n";
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #3 (SIMD KERNELS)
+// motivation: to test the vectorized convolution kernels against the scalar ones
+// features: forward, theorem, batched and inverse transforms for each instruction set available on this CPU,
+// results must be bit identical to the scalar path
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_thread_pool.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+
+int main()
+{
+	typedef ann::real_type				real_type;
+	typedef ann::real_vector_type		vector_type;
+	typedef fwt::DWT::matrix_type		matrix_type;
+
+	typedef std::chrono::steady_clock	clock_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t MAXTEST(1000);	// number of windows to transform for each analyzing wavelet
+
+	// create data obj
+	financials::data DATA(P);
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	const fwt::simd::isa_type ISA(fwt::simd::detect_isa());
+
+	cout << "Detected instruction set: " << fwt::simd::isa_name(ISA) << "\n\n";
+
+
+	for (size_t N=2; N<=10; ++N) // for each Daubechies wavelet type
+	{
+		fwt::DWT* D(nullptr);
+
+		try { D = fwt::create_Daubechies(N); }
+
+		catch (std::exception xe) {cout << xe.what() << "\ntest failure\n"; return 0;}
+
+
+		// theorem data, see engine
+		fwt::shift_variance_theorem SVT(PATSIZE, D->size()/2);
+
+		std::vector<size_t> VARIANT, BACKSTEPS;
+
+		SVT.variant_coefficients(VARIANT);
+
+		for (size_t n=PATSIZE/2; n>=std::pow(2.0, std::ceil(std::log2(D->size()))); n>>=1)
+
+			BACKSTEPS.push_back(SVT.back_steps(n));
+
+
+		// scalar reference: full transforms (matrix Q) and inverses of consecutive windows
+		D->set_isa(fwt::simd::isa_scalar);
+
+		matrix_type REF(MAXTEST, vector_type(PATSIZE)), REFINV(MAXTEST, vector_type(PATSIZE));
+
+		vector_type::const_pointer _Data(CLOSEBEG._Ptr);	// get ptr to source series
+
+		for (size_t i=0; i<MAXTEST; ++i)
+		{
+			D->transform(_Data+i, &REF[i][0], PATSIZE);
+
+			D->invert(&REF[i][0], &REFINV[i][0], PATSIZE);
+		}
+
+
+		for (size_t k=fwt::simd::isa_scalar; k<=ISA; ++k)
+		{
+			D->set_isa(static_cast<fwt::simd::isa_type>(k));
+
+			matrix_type Q(REF.cbegin(), REF.cbegin()+PATSIZE);	// history for the theorem
+
+			vector_type _Forward(PATSIZE), _Reconstruction(PATSIZE);
+
+			size_t _Errors(0);
+
+			const auto _Start(clock_type::now());
+
+			for (size_t i=PATSIZE; i<MAXTEST; ++i)
+			{
+				D->transform(_Data+i, &_Forward[0], PATSIZE);
+
+				_Errors += (_Forward!=REF[i]);
+
+				Q.push_back(vector_type(PATSIZE));
+
+				D->transform(VARIANT, BACKSTEPS, Q, _Data+i, &Q.back()[0], PATSIZE);
+
+				_Errors += (Q.back()!=REF[i]);
+
+				D->invert(&REF[i][0], &_Reconstruction[0], PATSIZE);
+
+				_Errors += (_Reconstruction!=REFINV[i]);
+			}
+
+			const auto _Elapsed(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+			// batched transforms of the same windows, interleaved and threaded
+			vector_type _Batch(MAXTEST*PATSIZE);
+
+			fwt::dwt_plan _Plan(*D, PATSIZE);
+
+			const auto _BatchStart(clock_type::now());
+
+			_Plan.execute_batch(_Data, &_Batch[0], MAXTEST, 1 /*hop*/, predictor_system::work_stealing_pool::shared());
+
+			const auto _BatchElapsed(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_BatchStart).count());
+
+			for (size_t i=0; i<MAXTEST; ++i) 
+				
+				_Errors += !std::equal(REF[i].cbegin(), REF[i].cend(), &_Batch[i*PATSIZE]);
+
+			cout << D->wavelet_type() << ", " << fwt::simd::isa_name(D->isa()) << ", "
+				<< (_Errors? "failed": "bit identical") << ", elapsed (us): " << _Elapsed 
+				<< ", batch of " << MAXTEST << " windows: " << _BatchElapsed << "\n";
+		}
+
+
+		// short series: most steps trepass the series borders
+		size_t _Errors(0);
+
+		for (size_t n=PATSIZE/2; n>=D->size(); n>>=1)
+		{
+			vector_type _Forward(n), _Reconstruction(n), _RefForward(n), _RefReconstruction(n);
+
+			D->set_isa(fwt::simd::isa_scalar);
+
+			D->transform(_Data, &_RefForward[0], n); D->invert(&_RefForward[0], &_RefReconstruction[0], n);
+
+			for (size_t k=fwt::simd::isa_scalar+1; k<=ISA; ++k)
+			{
+				D->set_isa(static_cast<fwt::simd::isa_type>(k));
+
+				D->transform(_Data, &_Forward[0], n); D->invert(&_RefForward[0], &_Reconstruction[0], n);
+
+				_Errors += (_Forward!=_RefForward) + (_Reconstruction!=_RefReconstruction);
+			}
+		}
+
+		cout << D->wavelet_type() << ", short series, " << (_Errors? "failed": "bit identical") << "\n\n";
+
+		delete D;
+	}
+
+	return 0;
+}
@@ -0,0 +1,178 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #4 (LIFTING SCHEME)
+// motivation: to test the lifting steps against the filter bank convolution
+// features: forward and inverse transforms within tolerance of the convolution, perfect reconstruction,
+// theorem transform bit identical to the full lifting transform, elapsed time of both schemes
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+
+int main()
+{
+	typedef ann::real_type				real_type;
+	typedef ann::real_vector_type		vector_type;
+	typedef fwt::DWT::matrix_type		matrix_type;
+
+	typedef std::chrono::steady_clock	clock_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t MAXTEST(1000);	// number of windows to transform for each analyzing wavelet
+	const real_type TOL(1e-10);	// max error relative to the window's largest magnitude
+
+	// create data obj
+	financials::data DATA(P);
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	vector_type::const_pointer _Data(CLOSEBEG._Ptr);	// get ptr to source series
+
+	auto _max_error = [](const vector_type& _A, const vector_type& _B) ->real_type
+	{// max abs difference, relative to the largest magnitude of _B
+		real_type _Err(0), _Mag(0);
+
+		for (size_t i=0; i<_A.size(); ++i)
+		{
+			_Err=std::max(_Err, std::abs(_A[i]-_B[i])); _Mag=std::max(_Mag, std::abs(_B[i]));
+		}
+
+		return _Mag? _Err/_Mag: _Err;
+	};
+
+
+	for (size_t N=2; N<=10; ++N) // for each Daubechies wavelet type
+	{
+		fwt::DWT* D(nullptr);
+
+		try { D = fwt::create_Daubechies(N); }
+
+		catch (std::exception xe) {cout << xe.what() << "\ntest failure\n"; return 0;}
+
+		D->set_isa(fwt::simd::isa_scalar);
+
+
+		// theorem data, see engine
+		fwt::shift_variance_theorem SVT(PATSIZE, D->size()/2);
+
+		std::vector<size_t> VARIANT, BACKSTEPS;
+
+		SVT.variant_coefficients(VARIANT);
+
+		for (size_t n=PATSIZE/2; n>=std::pow(2.0, std::ceil(std::log2(D->size()))); n>>=1)
+
+			BACKSTEPS.push_back(SVT.back_steps(n));
+
+
+		// convolution: full transforms and inverses of consecutive windows
+		D->set_scheme(fwt::scheme_convolution);
+
+		matrix_type REF(MAXTEST, vector_type(PATSIZE)), REFINV(MAXTEST, vector_type(PATSIZE));
+
+		auto _Start(clock_type::now());
+
+		for (size_t i=0; i<MAXTEST; ++i) D->transform(_Data+i, &REF[i][0], PATSIZE);
+
+		const auto _ConvForward(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+		_Start=clock_type::now();
+
+		for (size_t i=0; i<MAXTEST; ++i) D->invert(&REF[i][0], &REFINV[i][0], PATSIZE);
+
+		const auto _ConvInverse(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+
+		// lifting
+		D->set_scheme(fwt::scheme_lifting);
+
+		matrix_type LIFT(MAXTEST, vector_type(PATSIZE)), LIFTINV(MAXTEST, vector_type(PATSIZE));
+
+		_Start=clock_type::now();
+
+		for (size_t i=0; i<MAXTEST; ++i) D->transform(_Data+i, &LIFT[i][0], PATSIZE);
+
+		const auto _LiftForward(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+		_Start=clock_type::now();
+
+		for (size_t i=0; i<MAXTEST; ++i) D->invert(&REF[i][0], &LIFTINV[i][0], PATSIZE);
+
+		const auto _LiftInverse(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+
+		real_type _Forward(0), _Inverse(0), _Roundtrip(0);
+
+		vector_type _Reconstruction(PATSIZE);
+
+		for (size_t i=0; i<MAXTEST; ++i)
+		{
+			_Forward=std::max(_Forward, _max_error(LIFT[i], REF[i]));
+
+			_Inverse=std::max(_Inverse, _max_error(LIFTINV[i], REFINV[i]));
+
+			D->invert(&LIFT[i][0], &_Reconstruction[0], PATSIZE);
+
+			_Roundtrip=std::max(_Roundtrip, _max_error(_Reconstruction, vector_type(_Data+i, _Data+i+PATSIZE)));
+		}
+
+
+		// theorem by lifting steps against the full lifting transform
+		matrix_type Q(LIFT.cbegin(), LIFT.cbegin()+PATSIZE);
+
+		size_t _Errors(0);
+
+		for (size_t i=PATSIZE; i<MAXTEST; ++i)
+		{
+			Q.push_back(vector_type(PATSIZE));
+
+			D->transform(VARIANT, BACKSTEPS, Q, _Data+i, &Q.back()[0], PATSIZE);
+
+			_Errors += (Q.back()!=LIFT[i]);
+		}
+
+		// point and range inverses by lifting steps against the full lifting inverse
+		vector_type _RangeWork(D->range_workspace_size(PATSIZE)), _Range(PATSIZE/2);
+
+		size_t _PointErrors(0);
+
+		for (size_t i=0; i<MAXTEST; ++i)
+		{
+			D->invert_range(&REF[i][0], &_Range[0], PATSIZE, PATSIZE/4, PATSIZE/4+PATSIZE/2, &_RangeWork[0]);
+
+			_PointErrors += !std::equal(_Range.cbegin(), _Range.cend(), LIFTINV[i].cbegin()+PATSIZE/4);
+
+			_PointErrors += (D->invert_point(&REF[i][0], PATSIZE, PATSIZE-1, &_RangeWork[0]) != LIFTINV[i][PATSIZE-1]);
+		}
+
+		const bool _Passed(_Forward<TOL && _Inverse<TOL && _Roundtrip<TOL && !_Errors && !_PointErrors);
+
+		cout << D->wavelet_type() << ", " << (_Passed? "passed": "failed") << "\n"
+			<< "  max relative error, forward: " << _Forward << ", inverse: " << _Inverse
+			<< ", reconstruction: " << _Roundtrip << "\n"
+			<< "  theorem: " << (_Errors? "failed": "bit identical") 
+			<< ", point inverse: " << (_PointErrors? "failed": "bit identical") << "\n"
+			<< "  elapsed (us), convolution: " << _ConvForward << " + " << _ConvInverse
+			<< ", lifting: " << _LiftForward << " + " << _LiftInverse << "\n\n";
+
+		delete D;
+	}
+
+	return 0;
+}
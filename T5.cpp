@@ -0,0 +1,185 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #5 (SINGLE PRECISION)
+// motivation: to compare the float instantiation of the transform/engine stack against the double one
+// features: reconstruction MAE of both precisions (see test #1) and elapsed time of the transforms,
+// scalar and best instruction set; forecast MAE and elapsed time of a Daubechies 4 engine in both precisions
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+typedef std::chrono::steady_clock	clock_type;
+
+
+template <class T>
+inline auto _Transforms(const fwt::DWT_t<T>& D, const T* _Src, const double* _Actual,
+		const size_t& PATSIZE, const size_t& MAXTEST, double& _MAE) ->long long
+{
+	// transforms and inverses of MAXTEST consecutive windows, returns the elapsed time (us);
+	// _MAE: reconstruction error against the double series
+
+	std::vector<T> _Forward(PATSIZE), _Reconstruction(MAXTEST*PATSIZE);
+
+	const auto _Start(clock_type::now());
+
+	for (size_t i=0; i<MAXTEST; ++i)
+	{
+		D.transform(_Src+i, &_Forward[0], PATSIZE);
+
+		D.invert(&_Forward[0], &_Reconstruction[i*PATSIZE], PATSIZE);
+	}
+
+	const auto _Elapsed(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+	_MAE=0;
+
+	for (size_t i=0; i<MAXTEST; ++i)
+
+		for (size_t k=0; k<PATSIZE; ++k) _MAE += std::abs(_Actual[i+k] - _Reconstruction[i*PATSIZE+k]);
+
+	_MAE /= MAXTEST*PATSIZE;
+
+	return _Elapsed;
+}
+
+template <class engine_type, class _Init>
+inline auto _Forecasts(engine_type& _Engine, const size_t& PATSIZE, const size_t& QSIZE,
+		const size_t& MAXTEST, const _Init& _Beg, double& _MAE) ->long long
+{
+	// creates matrix Q, trains the machines, then forecasts MAXTEST samples;
+	// returns the elapsed time (us) of the whole run
+
+	const auto _Start(clock_type::now());
+
+	_Init I(_Beg);
+
+	for (const _Init E(I+QSIZE); I!=E; ++I) _Engine.update(I, I+PATSIZE); // creates Q matrix
+
+	for (const _Init E(I+QSIZE); I!=E; ++I) { _Engine.predict(); _Engine.update(I, I+PATSIZE); } // trains networks
+
+	_MAE=0;
+
+	for (const _Init E(I+MAXTEST); I!=E; ++I)
+	{
+		_MAE += std::abs(*(I+PATSIZE-1) - _Engine.predict(I, I+PATSIZE));
+
+		_Engine.update(I, I+PATSIZE);
+	}
+
+	_MAE /= MAXTEST;
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count();
+}
+
+
+int main()
+{
+	typedef ann::real_vector_type		vector_type;
+	typedef std::vector<float>			float_vector_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXTEST(1000);	// number of windows to transform for each analyzing wavelet
+	const size_t MAXFCST(1000);	// number of forecasts of each engine
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+	const auto CLOSEEND = DATA.close_end();
+
+	const float_vector_type CLOSEF(CLOSEBEG, CLOSEEND);	// single precision copy of the series
+
+	vector_type::const_pointer _Data(CLOSEBEG._Ptr);	// get ptr to source series
+
+	const fwt::simd::isa_type ISA(fwt::simd::detect_isa());
+
+	const fwt::simd::isa_type ISAS[] = { fwt::simd::isa_scalar, ISA };	// scalar and best instruction set
+
+	const size_t ISACOUNT(ISA==fwt::simd::isa_scalar? 1: 2);
+
+
+	// transforms
+	for (size_t N=2; N<=10; ++N) // for each Daubechies wavelet type
+	{
+		fwt::DWT* D(nullptr); fwt::DWT_t<float>* F(nullptr);
+
+		try { D = fwt::create_Daubechies(N); F = fwt::create_Daubechies<float>(N); }
+
+		catch (std::exception xe) {cout << xe.what() << "\ntest failure\n"; delete D; return 0;}
+
+		for (size_t k=0; k<ISACOUNT; ++k)
+		{
+			D->set_isa(ISAS[k]); F->set_isa(ISAS[k]);
+
+			double _DoubleMAE(0), _FloatMAE(0);
+
+			const auto _DoubleTime(_Transforms(*D, _Data, _Data, PATSIZE, MAXTEST, _DoubleMAE));
+
+			const auto _FloatTime(_Transforms(*F, &CLOSEF[0], _Data, PATSIZE, MAXTEST, _FloatMAE));
+
+			cout << D->wavelet_type() << ", " << fwt::simd::isa_name(D->isa())
+				<< ", reconstruction MAE double: " << _DoubleMAE << ", float: " << _FloatMAE
+				<< " (delta " << _FloatMAE-_DoubleMAE << ")\n"
+				<< "  elapsed (us), double: " << _DoubleTime << ", float: " << _FloatTime
+				<< ", speedup: " << (_FloatTime? double(_DoubleTime)/_FloatTime: 0) << "\n";
+		}
+
+		cout << "\n";
+
+		delete D; delete F;
+	}
+
+
+	// engines
+	predictor_system::engine<fwt::Daubechies<4>> DOUBLE_ENGINE(PATSIZE);
+
+	predictor_system::engine<fwt::Daubechies<4, float>> FLOAT_ENGINE(PATSIZE);
+
+	double _DoubleMAE(0), _FloatMAE(0);
+
+	const auto _DoubleTime(_Forecasts(DOUBLE_ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEBEG, _DoubleMAE));
+
+	const auto _FloatTime(_Forecasts(FLOAT_ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEF.cbegin(), _FloatMAE));
+
+	cout << "Engine, Daubechies 4, forecast MAE double: " << _DoubleMAE << ", float: " << _FloatMAE
+		<< " (delta " << _FloatMAE-_DoubleMAE << ")\n"
+		<< "  elapsed (us), double: " << _DoubleTime << ", float: " << _FloatTime
+		<< ", speedup: " << (_FloatTime? double(_DoubleTime)/_FloatTime: 0) << "\n";
+
+	return 0;
+}
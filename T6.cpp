@@ -0,0 +1,148 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #6 (MULTI SYMBOL ENGINE)
+// motivation: to test the multi symbol engine against one engine per symbol
+// features: K symbols (windows of the series, SHIFT samples apart), Q creation, training and forecasts;
+// forecasts must be bit identical, elapsed time of both
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+typedef std::chrono::steady_clock	clock_type;
+
+
+int main()
+{
+	typedef predictor_system::real_type							real_type;
+	typedef ann::real_vector_type								vector_type;
+	typedef fwt::Daubechies<4>									FWT_type;
+	typedef predictor_system::engine<FWT_type>					engine_type;
+	typedef predictor_system::multi_engine<FWT_type>			multi_engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t SYMBOLS(16);	// no. of symbols
+	const size_t SHIFT(500);	// samples between the windows of two symbols
+	const size_t MAXFCST(500);	// number of forecasts of each symbol
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	vector_type::const_pointer _Data(CLOSEBEG._Ptr);	// get ptr to source series
+
+	const size_t TICKS(2*QSIZE + MAXFCST);
+
+	if (DATA.close_end() - CLOSEBEG < static_cast<ptrdiff_t>(TICKS + (SYMBOLS-1)*SHIFT + PATSIZE)) 
+	{
+		cout << "series too short\ntest failure\n"; return 0;
+	}
+
+
+	// one engine per symbol, the MLPs draw their weights in the order of the symbols...
+	ann::_Re = ann::random_engine_type();
+
+	std::vector<engine_type*> ENGINES;
+
+	for (size_t s=0; s<SYMBOLS; ++s) ENGINES.push_back(new engine_type(PATSIZE));
+
+	// ... as those of the multi symbol engine
+	ann::_Re = ann::random_engine_type();
+
+	multi_engine_type MULTI(PATSIZE, SYMBOLS);
+
+
+	std::vector<vector_type> SINGLEFCST(TICKS, vector_type(SYMBOLS)), MULTIFCST(TICKS, vector_type(SYMBOLS));
+
+	// one engine per symbol
+	auto _Start(clock_type::now());
+
+	for (size_t t=0; t<TICKS; ++t)
+	{
+		for (size_t s=0; s<SYMBOLS; ++s)
+		{
+			const auto I(CLOSEBEG + t + s*SHIFT);
+
+			if (t>=QSIZE) SINGLEFCST[t][s] = ENGINES[s]->predict(); // Q created
+
+			ENGINES[s]->update(I, I+PATSIZE);
+		}
+	}
+
+	const auto _SingleTime(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+	// multi symbol engine
+	std::vector<vector_type::const_pointer> _Windows(SYMBOLS);
+
+	_Start=clock_type::now();
+
+	for (size_t t=0; t<TICKS; ++t)
+	{
+		if (t>=QSIZE) MULTI.predict(&MULTIFCST[t][0]); // Q created
+
+		for (size_t s=0; s<SYMBOLS; ++s) _Windows[s] = _Data + t + s*SHIFT;
+
+		MULTI.update(&_Windows[0]);
+	}
+
+	const auto _MultiTime(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count());
+
+
+	size_t _Errors(0);
+
+	real_type _MAE(0);
+
+	for (size_t t=QSIZE; t<TICKS; ++t) // training ticks as well
+	{
+		for (size_t s=0; s<SYMBOLS; ++s) _Errors += (SINGLEFCST[t][s] != MULTIFCST[t][s]);
+	}
+
+	for (size_t t=2*QSIZE; t<TICKS; ++t)
+	{
+		for (size_t s=0; s<SYMBOLS; ++s) _MAE += std::abs(MULTIFCST[t][s] - _Data[t + s*SHIFT + PATSIZE-1]);
+	}
+
+	cout << SYMBOLS << " symbols, " << MAXFCST << " forecasts each, "
+		<< (_Errors? "failed": "bit identical") << ", forecast MAE: " << _MAE/(SYMBOLS*MAXFCST) << "\n"
+		<< "  elapsed (us), one engine per symbol: " << _SingleTime << ", multi symbol engine: " << _MultiTime
+		<< ", speedup: " << (_MultiTime? double(_SingleTime)/_MultiTime: 0) << "\n";
+
+	for (auto I=ENGINES.begin(); I!=ENGINES.end(); ++I) predictor_system::safe_delete(*I);
+
+	return 0;
+}
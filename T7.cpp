@@ -0,0 +1,114 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #7 (PARALLEL TRAINING AND PREDICTION)
+// motivation: to test the retraining and the predict phase of the predictors on the thread pool against the serial ones
+// features: Q creation, training and forecasts of two engines, one worker and all cores;
+// forecasts must be bit identical, elapsed time and p99 predict latency of both
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+#include "DSPX_test_help.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+typedef std::chrono::steady_clock	clock_type;
+
+using predictor_system::percentile;
+
+
+template <class engine_type, class _Init>
+inline auto _Forecasts(engine_type& _Engine, const size_t& PATSIZE, const size_t& QSIZE,
+		const size_t& MAXTEST, const _Init& _Beg, std::vector<double>& _Fcst, std::vector<long long>& _Latency) ->long long
+{
+	// creates matrix Q, trains the machines, then forecasts MAXTEST samples;
+	// returns the elapsed time (us) of the whole run, the latency (ns) of each predict() in _Latency
+
+	const auto _Start(clock_type::now());
+
+	predictor_system::run_ticks(_Engine, PATSIZE, QSIZE, QSIZE+MAXTEST, _Beg, 
+		[&](size_t, double _F, double, long long _Predict, long long) { _Fcst.push_back(_F); _Latency.push_back(_Predict); });
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now()-_Start).count();
+}
+
+
+int main()
+{
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts of each engine
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	predictor_system::work_stealing_pool SERIAL(1);	// one worker, the caller
+
+	predictor_system::work_stealing_pool& PARALLEL(predictor_system::work_stealing_pool::shared());
+
+	cout << "Workers: " << PARALLEL.size() << "\n\n";
+
+
+	// the two engines draw the same weights
+	ann::_Re = ann::random_engine_type();
+
+	engine_type SERIAL_ENGINE(PATSIZE);
+
+	ann::_Re = ann::random_engine_type();
+
+	engine_type PARALLEL_ENGINE(PATSIZE);
+
+	SERIAL_ENGINE.set_thread_pool(SERIAL); PARALLEL_ENGINE.set_thread_pool(PARALLEL);
+
+
+	std::vector<double> _SerialFcst, _ParallelFcst;
+
+	std::vector<long long> _SerialLatency, _ParallelLatency;
+
+	const auto _SerialTime(_Forecasts(SERIAL_ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEBEG, _SerialFcst, _SerialLatency));
+
+	const auto _ParallelTime(_Forecasts(PARALLEL_ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEBEG, _ParallelFcst, _ParallelLatency));
+
+	cout << "Engine, Daubechies 4, " << _SerialFcst.size() << " forecasts, " 
+		<< ((_SerialFcst==_ParallelFcst)? "bit identical": "failed") << "\n"
+		<< "  elapsed (us), serial: " << _SerialTime << ", parallel: " << _ParallelTime
+		<< ", speedup: " << (_ParallelTime? double(_SerialTime)/_ParallelTime: 0) << "\n"
+		<< "  p99 predict latency (ns), serial: " << percentile(_SerialLatency, 99) << ", parallel: " << percentile(_ParallelLatency, 99) << "\n";
+
+	return 0;
+}
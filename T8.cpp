@@ -0,0 +1,131 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #8 (ASYNCHRONOUS TRAINING)
+// motivation: to test the retraining of the MLPs on background threads against the blocking one
+// features: Q creation, training and forecasts of two engines, synchronous and asynchronous retraining;
+// MAE of both, p99 tick latency (predict and update), staleness of the published weights
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+#include "DSPX_test_help.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+
+struct tick_stats
+{
+	tick_stats() : _Mae(0), _P99(0), _MaxStale(0), _MeanStale(0) {}
+
+	double			_Mae;		// mean absolute error of the forecasts
+	long long		_P99;		// p99 tick latency (ns)
+	size_t			_MaxStale;	// max staleness of the published weights (ticks)
+	double			_MeanStale;	// mean of the max staleness of each tick
+};
+
+template <class engine_type, class _Init>
+inline auto _Run(engine_type& _Engine, const size_t& PATSIZE, const size_t& QSIZE,
+		const size_t& MAXTEST, const _Init& _Beg) ->tick_stats
+{
+	// creates matrix Q, trains the machines for QSIZE ticks, then forecasts MAXTEST samples
+	// measuring the latency of each tick
+
+	tick_stats _Stats;
+
+	std::vector<long long> _Latency;
+
+	predictor_system::run_ticks(_Engine, PATSIZE, QSIZE, QSIZE+MAXTEST, _Beg, 
+		[&](size_t t, double _Fcst, double _Actual, long long, long long _Tick)
+	{
+		if (t < QSIZE) return; // trains networks
+
+		_Latency.push_back(_Tick);
+
+		_Stats._Mae += std::abs(_Fcst - _Actual); // the newest sample of the window
+
+		const size_t _Stale(_Engine.max_staleness());
+
+		_Stats._MaxStale = std::max(_Stats._MaxStale, _Stale); _Stats._MeanStale += _Stale;
+	});
+
+	_Stats._Mae /= MAXTEST; _Stats._MeanStale /= MAXTEST;
+
+	_Stats._P99 = predictor_system::percentile(_Latency, 99);
+
+	return _Stats;
+}
+
+inline void _Print(const char* _Name, const tick_stats& _Stats)
+{
+	cout << _Name << " MAE: " << _Stats._Mae << ", p99 tick latency (ns): " << _Stats._P99 
+		<< ", staleness (ticks) max: " << _Stats._MaxStale << ", mean: " << _Stats._MeanStale << "\n";
+}
+
+
+int main()
+{
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts of each engine
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	cout << "Background threads: " << predictor_system::background_queue::shared().size() << "\n\n";
+
+
+	// the two engines draw the same weights
+	ann::_Re = ann::random_engine_type();
+
+	engine_type SYNC_ENGINE(PATSIZE);
+
+	ann::_Re = ann::random_engine_type();
+
+	engine_type ASYNC_ENGINE(PATSIZE);
+
+	ASYNC_ENGINE.set_async_training(true);
+
+
+	_Print("Synchronous, Daubechies 4,", _Run(SYNC_ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEBEG));
+
+	_Print("Asynchronous, Daubechies 4,", _Run(ASYNC_ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEBEG));
+
+	ASYNC_ENGINE.wait_training();
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+// Copyright (c) <2016> <Marco Stocchi, UNICA>
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// TEST #9 (BUDGETED TRAINING)
+// motivation: to test the per tick training budget of the engine against the unbounded retraining
+// features: Q creation, training and forecasts of engines with decreasing budgets of training passes per tick;
+// MAE, p99 tick latency (predict and update), max passes of a tick and no. of predictors left by the budget;
+// divergence of a single training (gradient ascent, negative learning rate) and the rollback of its weights
+// output type: console
+
+#include "stdafx.h"
+#include "DSPX_ann_def.h"
+#include "DSPX_ann_helper.h"
+#include "DSPX_ann_neuron.h"
+#include "DSPX_ann_layer.h"
+#include "DSPX_ann_layer_input.h"
+#include "DSPX_ann_neuron_perceptron.h"
+#include "DSPX_ann_neuron_output.h"
+#include "DSPX_ann_layer_perceptron.h"
+#include "DSPX_ann_layer_output.h"
+#include "DSPX_ann_network.h"
+#include "DSPX_ann_network_perceptron.h"
+#include "DSPX_ann_network_help.h"
+#include "DSPX_financial_convert.h"
+#include "DSPX_financial_bar.h"
+#include "DSPX_financial_data.h"
+#include "DSPX_circular_matrix.h"
+#include "DSPX_fast_wavelet_transform_simd.h"
+#include "DSPX_fast_wavelet_transform_lifting.h"
+#include "DSPX_fast_wavelet_transform.h"
+#include "DSPX_help.h"
+#include "DSPX_thread_pool.h"
+#include "DSPX_latency.h"
+#include "DSPX_engine.h"
+#include "DSPX_test_help.h"
+
+#define BARSFILE		"DATA\\H1_13_15.txt" // 2013.01.01 00:00 -> 2015.06.30 22:00
+
+
+struct tick_stats
+{
+	tick_stats() : _Mae(0), _P99(0), _MaxIterations(0), _Exhausted(0) {}
+
+	double			_Mae;			// mean absolute error of the forecasts
+	long long		_P99;			// p99 tick latency (ns)
+	size_t			_MaxIterations;	// max training passes of a tick
+	size_t			_Exhausted;		// predictors left by the budget, all ticks
+};
+
+template <class engine_type, class _Init>
+inline auto _Run(engine_type& _Engine, const size_t& PATSIZE, const size_t& QSIZE,
+		const size_t& MAXTEST, const _Init& _Beg) ->tick_stats
+{
+	// creates matrix Q, trains the machines for QSIZE ticks, then forecasts MAXTEST samples
+	// measuring the latency of each tick
+
+	tick_stats _Stats;
+
+	std::vector<long long> _Latency;
+
+	predictor_system::run_ticks(_Engine, PATSIZE, QSIZE, QSIZE+MAXTEST, _Beg, 
+		[&](size_t t, double _Fcst, double _Actual, long long, long long _Tick)
+	{
+		if (t < QSIZE) return; // trains networks
+
+		_Latency.push_back(_Tick);
+
+		_Stats._Mae += std::abs(_Fcst - _Actual); // the newest sample of the window
+
+		_Stats._MaxIterations = std::max(_Stats._MaxIterations, _Engine.tick_iterations()); 
+		
+		_Stats._Exhausted += _Engine.tick_exhausted();
+	});
+
+	_Stats._Mae /= MAXTEST;
+
+	_Stats._P99 = predictor_system::percentile(_Latency, 99);
+
+	return _Stats;
+}
+
+
+int main()
+{
+	typedef predictor_system::engine<fwt::Daubechies<4>>		engine_type;
+
+	// source file paths
+	const path_type P(BARSFILE);
+
+	// constants
+	const size_t PATSIZE(128);	// source series analyzing window size
+	const size_t QSIZE(PATSIZE);	// size of matrix Q
+	const size_t MAXFCST(1000);	// number of forecasts of each engine
+
+	const size_t BUDGETS[] = {0 /*unbounded*/, 1000, 100, 10}; // training passes per tick
+
+	// create data obj
+	financials::data DATA(P);
+
+	if (financials::_Failure(DATA)) return 0;
+
+	const auto CLOSEBEG = DATA.close_begin();
+
+	for (size_t b=0; b<sizeof(BUDGETS)/sizeof(size_t); ++b)
+	{
+		// the engines draw the same weights
+		ann::_Re = ann::random_engine_type();
+
+		engine_type ENGINE(PATSIZE);
+
+		ENGINE.set_training_budget(BUDGETS[b]);
+
+		const tick_stats _Stats(_Run(ENGINE, PATSIZE, QSIZE, MAXFCST, CLOSEBEG));
+
+		cout << "Budget " << BUDGETS[b] << ", Daubechies 4, MAE: " << _Stats._Mae << ", p99 tick latency (ns): " << _Stats._P99 
+			<< ", max passes: " << _Stats._MaxIterations << ", left: " << _Stats._Exhausted << "\n";
+	}
+
+	const double RATES[] = {0.1, -0.1}; // learning rates: descent, ascent (diverges)
+
+	for (size_t r=0; r<sizeof(RATES)/sizeof(double); ++r)
+	{
+		// a default predictor network trained on one pattern of first differences
+		ann::_Re = ann::random_engine_type();
+
+		predictor_system::m1lp_type NET(8, 16, 1);
+
+		NET.set_learning_rate(RATES[r]);
+
+		std::vector<double> _Pattern(8);
+
+		for (size_t k=0; k<_Pattern.size(); ++k) _Pattern[k] = std::tanh(*(CLOSEBEG+k+1) - *(CLOSEBEG+k));
+
+		const double _Actual(0.5), _Err(NET.test_single(_Pattern.cbegin(), _Pattern.cend()) - _Actual);
+
+		std::stringstream _Before, _After;
+
+		NET.write(_Before);
+
+		size_t _Passes(0);
+
+		const ann::training_status _Status(ann::network_train_single(NET, _Pattern, _Err, 0.0, 0.000001, _Actual, 
+			ann::training_budget(100000), _Passes));
+
+		NET.write(_After);
+
+		cout << "Learning rate " << RATES[r] << ", " << (_Status==ann::training_diverged? "diverged": 
+			_Status==ann::training_budget_exhausted? "budget exhausted": "converged") 
+			<< " after " << _Passes << " passes, weights " << (_Before.str()==_After.str()? "rolled back": "trained") << "\n";
+	}
+
+	return 0;
+}
@@ -5,6 +5,8 @@
 #pragma once
 #pragma warning (disable: 4996) // -D_SCL_SECURE_NO_WARNINGS
 
+//#define DSPX_LATENCY	// per phase latency histograms of the engine, see DSPX_latency.h
+
 #include "targetver.h"
 #include <stdio.h>
 #include <tchar.h>
@@ -21,6 +23,7 @@
 #include <unordered_set>
 #include <array>
 #include <tuple>
+#include <cstdint>
 
 #include <algorithm>
 
@@ -31,8 +34,19 @@
 #include <iomanip>
 
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <atomic>
+
+#include <intrin.h>		// __cpuid, _xgetbv
+#include <immintrin.h>	// AVX2, AVX-512
 
 #include <boost\filesystem.hpp>
+#include <boost\iostreams\device\mapped_file.hpp>
 
 typedef boost::filesystem::directory_entry		directory_entry;
 typedef boost::filesystem::directory_iterator	directory_iterator;